@@ -0,0 +1,36 @@
+#include <benchmark/benchmark.h>
+
+#include "../include/Game.hpp"
+
+static const std::string STARTING_POSITION = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+static void BM_ConstructGame(benchmark::State &state)
+{
+	// The first game builds the process-wide tables, which is not what is being measured
+	Game warmUp(STARTING_POSITION);
+
+	for (auto _ : state)
+	{
+		Game game(STARTING_POSITION);
+		benchmark::DoNotOptimize(game);
+	}
+}
+
+BENCHMARK(BM_ConstructGame);
+
+static void BM_CopyBoard(benchmark::State &state)
+{
+	Game game(STARTING_POSITION);
+
+	for (auto _ : state)
+	{
+		Board board = game.getBoard();
+		benchmark::DoNotOptimize(board);
+	}
+
+	state.counters["Bytes"] = sizeof(Board);
+}
+
+BENCHMARK(BM_CopyBoard);
+
+BENCHMARK_MAIN();
\ No newline at end of file
@@ -0,0 +1,322 @@
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <vector>
+
+#include "../include/Game.hpp"
+#include "../include/MagicBitboards.hpp"
+#include "../include/MoveGenerator.hpp"
+#include "../include/MoveValidator.hpp"
+#include "../include/Search.hpp"
+#include "../include/StaticExchange.hpp"
+
+// Every benchmark runs over the whole corpus per iteration, so numbers from different builds are directly comparable.
+// Results are written as JSON unless another format is asked for on the command line
+static const std::vector<std::string> CORPUS = {
+	"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+	"r1bqkb1r/pppp1ppp/2n2n2/4p3/2B1P3/5N2/PPPP1PPP/RNBQK2R w KQkq - 4 4",
+	"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+	"r1bq1rk1/1pp2ppp/p4n2/2bpp3/B2nP3/2NPBP2/PPP3PP/R2QK1NR w KQ d6 0 9",
+	"r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+	"rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+	"r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+	"8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+	"8/5pk1/6p1/3P3p/1p3P1P/1P4K1/8/8 b - - 0 45",
+	"4r1k1/5ppp/8/8/8/8/5PPP/3R2K1 w - - 0 30",
+};
+
+// Open positions dominated by queens, rooks and bishops, where slider lookups are most of the move generation work
+static const std::vector<std::string> SLIDER_HEAVY_CORPUS = {
+	"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+	"R6R/3Q4/1Q4Q1/4Q3/2Q4Q/Q4Q2/pp1Q4/kBNN1KB1 w - - 0 1",
+	"3r1rk1/1b2qppp/p7/1p6/8/1B3Q2/PPP2PPP/3RR1K1 w - - 0 20",
+	"2rq1rk1/pb3ppp/1p2p3/8/2PP4/P2B1Q2/5PPP/2R1R1K1 b - - 0 18",
+	"q3k2r/1b3ppp/8/8/8/8/1B3PPP/Q3K2R w Kk - 0 1",
+};
+
+static std::vector<Game> createCorpusGames(const std::vector<std::string> &corpus = CORPUS)
+{
+	std::vector<Game> games;
+	for (const std::string &fen : corpus)
+	{
+		games.emplace_back(fen);
+	}
+	return games;
+}
+
+using SliderAttacks = Bitboard (*)(int square, Bitboard occupied, PieceType pieceType);
+
+// Attacks from every square against each position's real occupancy
+static void BM_GetSliderAttacks(benchmark::State &state, SliderAttacks getAttacks, PieceType pieceType)
+{
+	std::vector<Game> games = createCorpusGames();
+	std::vector<Bitboard> occupancies;
+	for (Game &game : games)
+	{
+		occupancies.push_back(game.getBoard().getOccupiedBitboard());
+	}
+
+	for (auto _ : state)
+	{
+		uint64_t attacks = 0;
+		for (Bitboard occupied : occupancies)
+		{
+			for (int square = 0; square < 64; square++)
+			{
+				attacks ^= getAttacks(square, occupied, pieceType).getValue();
+			}
+		}
+		benchmark::DoNotOptimize(attacks);
+	}
+
+	state.SetItemsProcessed(state.iterations() * occupancies.size() * 64);
+}
+
+BENCHMARK_CAPTURE(BM_GetSliderAttacks, Rook, MagicBitboards::getSliderAttacks, PieceType::ROOK);
+BENCHMARK_CAPTURE(BM_GetSliderAttacks, Bishop, MagicBitboards::getSliderAttacks, PieceType::BISHOP);
+BENCHMARK_CAPTURE(BM_GetSliderAttacks, Queen, MagicBitboards::getSliderAttacks, PieceType::QUEEN);
+
+// The backends side by side, the PEXT one only exists in builds targeting BMI2
+BENCHMARK_CAPTURE(BM_GetSliderAttacks, MagicRook, MagicBitboards::getMagicSliderAttacks, PieceType::ROOK);
+BENCHMARK_CAPTURE(BM_GetSliderAttacks, MagicBishop, MagicBitboards::getMagicSliderAttacks, PieceType::BISHOP);
+#ifdef USE_PEXT
+BENCHMARK_CAPTURE(BM_GetSliderAttacks, PextRook, MagicBitboards::getPextSliderAttacks, PieceType::ROOK);
+BENCHMARK_CAPTURE(BM_GetSliderAttacks, PextBishop, MagicBitboards::getPextSliderAttacks, PieceType::BISHOP);
+#endif
+
+static void BM_IsSquareAttacked(benchmark::State &state)
+{
+	std::vector<Game> games = createCorpusGames();
+
+	for (auto _ : state)
+	{
+		int attackedSquares = 0;
+		for (Game &game : games)
+		{
+			for (int square = 0; square < 64; square++)
+			{
+				attackedSquares += MoveValidator::isSquareAttacked(game.getBoard(), game.getActiveColor(), square);
+			}
+		}
+		benchmark::DoNotOptimize(attackedSquares);
+	}
+
+	state.SetItemsProcessed(state.iterations() * games.size() * 64);
+}
+
+BENCHMARK(BM_IsSquareAttacked);
+
+static void BM_AttackersTo(benchmark::State &state)
+{
+	std::vector<Game> games = createCorpusGames();
+
+	for (auto _ : state)
+	{
+		uint64_t attackers = 0;
+		for (Game &game : games)
+		{
+			Board &board = game.getBoard();
+			Bitboard occupied = board.getOccupiedBitboard();
+			for (int square = 0; square < 64; square++)
+			{
+				attackers ^= board.attackersTo(square, occupied).getValue();
+			}
+		}
+		benchmark::DoNotOptimize(attackers);
+	}
+
+	state.SetItemsProcessed(state.iterations() * games.size() * 64);
+}
+
+BENCHMARK(BM_AttackersTo);
+
+static void BM_FindAbsolutePins(benchmark::State &state)
+{
+	std::vector<Game> games = createCorpusGames();
+
+	for (auto _ : state)
+	{
+		uint64_t pinned = 0;
+		for (Game &game : games)
+		{
+			pinned ^= MoveValidator::findAbsolutePins(game.getBoard(), game.getActiveColor()).getValue();
+		}
+		benchmark::DoNotOptimize(pinned);
+	}
+
+	state.SetItemsProcessed(state.iterations() * games.size());
+}
+
+BENCHMARK(BM_FindAbsolutePins);
+
+// Plays and takes back every legal move of every position
+static void BM_MoveUnmovePiece(benchmark::State &state)
+{
+	std::vector<Game> games = createCorpusGames();
+	std::vector<MoveList> moveLists(games.size());
+	int64_t moveCount = 0;
+	for (size_t i = 0; i < games.size(); i++)
+	{
+		games[i].generateLegalMoves(moveLists[i]);
+		moveCount += moveLists[i].size();
+	}
+
+	for (auto _ : state)
+	{
+		for (size_t i = 0; i < games.size(); i++)
+		{
+			Board &board = games[i].getBoard();
+			Color color = games[i].getActiveColor();
+			// unmovePiece leaves the en passant square to Game, restoring it also restores the zobrist key
+			std::optional<Position> enPassantTargetSquare = board.getEnPassantTargetSquare();
+			for (Move move : moveLists[i])
+			{
+				std::optional<PieceType> capturedPiece = board.movePiece(move, color);
+				board.unmovePiece(move, color, capturedPiece);
+				board.setEnPassantTargetSquare(enPassantTargetSquare);
+			}
+		}
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * moveCount);
+}
+
+BENCHMARK(BM_MoveUnmovePiece);
+
+static void BM_GenerateLegalMoves(benchmark::State &state, const std::vector<std::string> &corpus)
+{
+	std::vector<Game> games = createCorpusGames(corpus);
+	MoveList moves;
+
+	for (auto _ : state)
+	{
+		for (Game &game : games)
+		{
+			game.generateLegalMoves(moves);
+			benchmark::DoNotOptimize(moves);
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * games.size());
+}
+
+BENCHMARK_CAPTURE(BM_GenerateLegalMoves, Corpus, CORPUS);
+BENCHMARK_CAPTURE(BM_GenerateLegalMoves, SliderHeavy, SLIDER_HEAVY_CORPUS);
+
+// Exchange evaluation of every capture, the way quiescence search orders and prunes them
+static void BM_StaticExchange(benchmark::State &state)
+{
+	std::vector<Game> games = createCorpusGames(SLIDER_HEAVY_CORPUS);
+	std::vector<MoveList> captureLists(games.size());
+	int64_t captureCount = 0;
+	for (size_t i = 0; i < games.size(); i++)
+	{
+		MoveGenerator::generate<GenType::CAPTURES>(games[i], captureLists[i]);
+		captureCount += captureLists[i].size();
+	}
+
+	for (auto _ : state)
+	{
+		int total = 0;
+		for (size_t i = 0; i < games.size(); i++)
+		{
+			for (Move move : captureLists[i])
+			{
+				total += StaticExchange::see(games[i].getBoard(), move);
+			}
+		}
+		benchmark::DoNotOptimize(total);
+	}
+
+	state.SetItemsProcessed(state.iterations() * captureCount);
+}
+
+BENCHMARK(BM_StaticExchange);
+
+// Fixed depth searches of the whole corpus, NPS covers both the alpha-beta and the quiescence nodes
+static void BM_Search(benchmark::State &state)
+{
+	std::vector<Game> games = createCorpusGames();
+	SearchLimits limits;
+	limits.depth = state.range(0);
+	uint64_t nodes = 0;
+
+	for (auto _ : state)
+	{
+		nodes = 0;
+		for (Game &game : games)
+		{
+			nodes += Search(game).run(limits).nodes;
+		}
+	}
+
+	state.counters["Nodes"] = nodes;
+	state.counters["NPS"] = benchmark::Counter(nodes * state.iterations(), benchmark::Counter::kIsRate);
+}
+
+BENCHMARK(BM_Search)->DenseRange(3, 5)->Unit(benchmark::kMillisecond);
+
+static void BM_ParseFen(benchmark::State &state)
+{
+	// The first game builds the process-wide tables, which is not what is being measured
+	Game warmUp(CORPUS[0]);
+
+	for (auto _ : state)
+	{
+		for (const std::string &fen : CORPUS)
+		{
+			Game game(fen);
+			benchmark::DoNotOptimize(game);
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * CORPUS.size());
+}
+
+BENCHMARK(BM_ParseFen);
+
+static void BM_GetFen(benchmark::State &state)
+{
+	std::vector<Game> games = createCorpusGames();
+
+	for (auto _ : state)
+	{
+		for (Game &game : games)
+		{
+			std::string fen = game.getFen();
+			benchmark::DoNotOptimize(fen);
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * games.size());
+}
+
+BENCHMARK(BM_GetFen);
+
+int main(int argc, char **argv)
+{
+	std::vector<char *> arguments(argv, argv + argc);
+	bool formatGiven = false;
+	for (int i = 1; i < argc; i++)
+	{
+		formatGiven |= std::strncmp(argv[i], "--benchmark_format", 18) == 0;
+	}
+
+	char jsonFormat[] = "--benchmark_format=json";
+	if (!formatGiven)
+	{
+		arguments.push_back(jsonFormat);
+	}
+
+	int argumentCount = arguments.size();
+	benchmark::Initialize(&argumentCount, arguments.data());
+	if (benchmark::ReportUnrecognizedArguments(argumentCount, arguments.data()))
+	{
+		return 1;
+	}
+
+	benchmark::RunSpecifiedBenchmarks();
+	benchmark::Shutdown();
+	return 0;
+}
\ No newline at end of file
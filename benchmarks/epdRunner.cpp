@@ -0,0 +1,236 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../include/Game.hpp"
+
+// Checks perft counts from an EPD file such as "<fen> ;D1 20 ;D2 400", reading it line by line so file size does not matter.
+// Usage: epdRunner <file> [threads] [max depth]
+
+static const std::string STARTING_POSITION = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+struct EpdLine
+{
+	uint64_t lineNumber;
+	std::string text;
+};
+
+// Lines waiting for a worker, bounded so the reader never gets far ahead of the workers
+class EpdQueue
+{
+public:
+	EpdQueue(size_t capacity) : capacity(capacity) {}
+
+	void push(EpdLine line)
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		notFull.wait(lock, [this]() { return lines.size() < capacity; });
+		lines.push_back(std::move(line));
+		notEmpty.notify_one();
+	}
+
+	bool pop(EpdLine &line)
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		notEmpty.wait(lock, [this]() { return !lines.empty() || finished; });
+		if (lines.empty())
+		{
+			return false;
+		}
+
+		line = std::move(lines.front());
+		lines.pop_front();
+		notFull.notify_one();
+		return true;
+	}
+
+	void finish()
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		finished = true;
+		notEmpty.notify_all();
+	}
+
+private:
+	std::mutex mutex;
+	std::condition_variable notFull;
+	std::condition_variable notEmpty;
+	std::deque<EpdLine> lines;
+	size_t capacity;
+	bool finished = false;
+};
+
+struct EpdStats
+{
+	std::atomic<uint64_t> positions{0};
+	std::atomic<uint64_t> checks{0};
+	std::atomic<uint64_t> failures{0};
+	std::atomic<uint64_t> errors{0}; // Lines skipped because their position could not be parsed
+	std::atomic<uint64_t> nodes{0};
+};
+
+static std::mutex outputMutex;
+
+// Parses a whole argument as a number from 1 to 1024, anything else is rejected
+static bool parsePositiveArgument(const char *argument, int &value)
+{
+	char *end = nullptr;
+	long parsed = std::strtol(argument, &end, 10);
+	if (end == argument || *end != '\0' || parsed < 1 || parsed > 1024)
+	{
+		return false;
+	}
+
+	value = static_cast<int>(parsed);
+	return true;
+}
+
+// Returns false if a count did not match, a line whose position cannot be parsed is skipped and counted as an error
+static bool checkLine(Game &game, const EpdLine &line, int maxDepth, EpdStats &stats)
+{
+	size_t separator = line.text.find(';');
+	std::string fen = line.text.substr(0, separator);
+	fen.erase(fen.find_last_not_of(" \t\r") + 1);
+
+	// EPD positions usually leave out the clocks
+	if (std::count(fen.begin(), fen.end(), ' ') == 3)
+	{
+		fen += " 0 1";
+	}
+
+	try
+	{
+		game.setFen(fen);
+	}
+	catch (const std::exception &e)
+	{
+		std::lock_guard<std::mutex> lock(outputMutex);
+		std::cout << "Line " << line.lineNumber << ": could not parse \"" << fen << "\": " << e.what() << "\n";
+		stats.errors++;
+		return true;
+	}
+
+	stats.positions++;
+
+	std::istringstream fields(separator == std::string::npos ? "" : line.text.substr(separator));
+	std::string field;
+	while (std::getline(fields, field, ';'))
+	{
+		std::istringstream tokens(field);
+		std::string depthToken;
+		uint64_t expectedNodes = 0;
+		if (!(tokens >> depthToken >> expectedNodes) || depthToken.size() < 2 || depthToken[0] != 'D')
+		{
+			continue;
+		}
+
+		int depth = std::atoi(depthToken.c_str() + 1);
+		if (depth < 1 || depth > maxDepth)
+		{
+			continue;
+		}
+
+		uint64_t nodes = game.perft(depth);
+		stats.checks++;
+		stats.nodes += nodes;
+
+		if (nodes != expectedNodes)
+		{
+			// The divide narrows a mismatch down to the root moves whose subtrees disagree with a reference engine
+			std::map<std::string, uint64_t> divide;
+			game.perftRoot(depth, divide);
+
+			std::lock_guard<std::mutex> lock(outputMutex);
+			std::cout << "Line " << line.lineNumber << ": depth " << depth << " expected " << expectedNodes << " got " << nodes << "\n";
+			std::cout << "  " << fen << "\n";
+			for (const auto &[move, moveNodes] : divide)
+			{
+				std::cout << "  " << move << ": " << moveNodes << "\n";
+			}
+			return false;
+		}
+	}
+
+	return true;
+}
+
+int main(int argc, char **argv)
+{
+	if (argc < 2)
+	{
+		std::cerr << "Usage: " << argv[0] << " <file> [threads] [max depth]\n";
+		return EXIT_FAILURE;
+	}
+
+	std::ifstream file(argv[1]);
+	if (!file)
+	{
+		std::cerr << "Could not open " << argv[1] << "\n";
+		return EXIT_FAILURE;
+	}
+
+	int threadCount = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+	int maxDepth = 6;
+	if ((argc > 2 && !parsePositiveArgument(argv[2], threadCount)) || (argc > 3 && !parsePositiveArgument(argv[3], maxDepth)))
+	{
+		std::cerr << "Usage: " << argv[0] << " <file> [threads] [max depth] - threads and max depth must be positive numbers\n";
+		return EXIT_FAILURE;
+	}
+
+	EpdQueue queue(threadCount * 64);
+	EpdStats stats;
+	auto start = std::chrono::steady_clock::now();
+
+	// Each worker keeps one game and loads every position into it
+	std::vector<std::thread> workers;
+	for (int thread = 0; thread < threadCount; thread++)
+	{
+		workers.emplace_back([&queue, &stats, maxDepth]() {
+			Game game(STARTING_POSITION);
+			EpdLine line;
+			while (queue.pop(line))
+			{
+				if (!checkLine(game, line, maxDepth, stats))
+				{
+					stats.failures++;
+				}
+			}
+		});
+	}
+
+	std::string text;
+	uint64_t lineNumber = 0;
+	while (std::getline(file, text))
+	{
+		lineNumber++;
+		if (text.empty() || text[0] == '#' || text.find_first_not_of(" \t\r") == std::string::npos)
+		{
+			continue;
+		}
+
+		queue.push(EpdLine{lineNumber, std::move(text)});
+	}
+	queue.finish();
+
+	for (std::thread &worker : workers)
+	{
+		worker.join();
+	}
+
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	std::cout << "Positions: " << stats.positions << ", checks: " << stats.checks << ", failures: " << stats.failures << ", errors: " << stats.errors << "\n";
+	std::cout << "Nodes: " << stats.nodes << " in " << seconds << "s (" << static_cast<uint64_t>(seconds > 0 ? stats.nodes / seconds : 0) << " nps)\n";
+
+	return stats.failures == 0 && stats.errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
\ No newline at end of file
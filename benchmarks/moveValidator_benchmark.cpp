@@ -0,0 +1,32 @@
+#include <benchmark/benchmark.h>
+
+#include "../include/Game.hpp"
+#include "../include/MoveValidator.hpp"
+
+static const std::string STARTING_POSITION = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+static const std::string KIWIPETE = "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1";
+
+// Asks whether every square is attacked by the opponent, which exercises the occupancy lookups for every slider
+static void BM_IsSquareAttacked(benchmark::State &state, std::string fen)
+{
+	Game game(fen);
+	Board &board = game.getBoard();
+	Color color = game.getActiveColor();
+
+	for (auto _ : state)
+	{
+		int attackedSquares = 0;
+		for (int square = 0; square < 64; square++)
+		{
+			attackedSquares += MoveValidator::isSquareAttacked(board, color, square);
+		}
+		benchmark::DoNotOptimize(attackedSquares);
+	}
+
+	state.SetItemsProcessed(state.iterations() * 64);
+}
+
+BENCHMARK_CAPTURE(BM_IsSquareAttacked, StartingPosition, STARTING_POSITION);
+BENCHMARK_CAPTURE(BM_IsSquareAttacked, Kiwipete, KIWIPETE);
+
+BENCHMARK_MAIN();
\ No newline at end of file
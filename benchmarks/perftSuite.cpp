@@ -0,0 +1,104 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../include/Game.hpp"
+
+// Standalone perft run over the standard positions, prints nodes, time and NPS per position to track move generator throughput.
+// Usage: perftSuite [max depth], positions are searched to the deepest listed count that is not above the max depth
+
+struct PerftSuitePosition
+{
+	std::string name;
+	std::string fen;
+	std::vector<uint64_t> expectedNodes; // Index 0 is depth 1
+};
+
+static const std::vector<PerftSuitePosition> PERFT_SUITE = {
+	// Positions 1 to 6 from the chess programming wiki perft results page
+	{"Start position", "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", {20, 400, 8902, 197281, 4865609, 119060324}},
+	{"Kiwipete", "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", {48, 2039, 97862, 4085603, 193690690}},
+	{"Position 3", "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1", {14, 191, 2812, 43238, 674624, 11030083}},
+	{"Position 4", "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1", {6, 264, 9467, 422333, 15833292}},
+	{"Position 4 mirrored", "r2q1rk1/pP1p2pp/Q4n2/bbp1p3/Np6/1B3NBn/pPPP1PPP/R3K2R b KQ - 0 1", {6, 264, 9467, 422333, 15833292}},
+	{"Position 5", "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8", {44, 1486, 62379, 2103487, 89941194}},
+	{"Position 6", "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10", {46, 2079, 89890, 3894594, 164075551}},
+	// En passant edge cases
+	{"Illegal en passant, pinned on the rank", "3k4/3p4/8/K1P4r/8/8/8/8 b - - 0 1", {18, 92, 1670, 10138, 185429, 1134888}},
+	{"Illegal en passant, pinned on the diagonal", "8/8/4k3/8/2p5/8/B2P2K1/8 w - - 0 1", {13, 102, 1266, 10276, 135655, 1015133}},
+	{"En passant capture gives check", "8/8/1k6/2b5/2pP4/8/5K2/8 b - d3 0 1", {15, 126, 1928, 13931, 206379, 1440467}},
+	// Castling edge cases
+	{"Short castling gives check", "5k2/8/8/8/8/8/8/4K2R w K - 0 1", {15, 66, 1198, 6399, 120330, 661072}},
+	{"Long castling gives check", "3k4/8/8/8/8/8/8/R3K3 w Q - 0 1", {16, 71, 1286, 7418, 141077, 803711}},
+	{"Castling rights lost by rook captures", "r3k2r/1b4bq/8/8/8/8/7B/R3K2R w KQkq - 0 1", {26, 1141, 27826, 1274206}},
+	{"Castling prevented by attacks", "r3k2r/8/3Q4/8/8/5q2/8/R3K2R b KQkq - 0 1", {44, 1494, 50509, 1720476}},
+	// Promotion edge cases
+	{"Promotion out of check", "2K2r2/4P3/8/8/8/8/8/3k4 w - - 0 1", {11, 133, 1442, 19174, 266199, 3821001}},
+	{"Promotion gives check", "4k3/1P6/8/8/8/8/K7/8 w - - 0 1", {9, 40, 472, 2661, 38983, 217342}},
+	{"Underpromotion gives check", "8/P1k5/K7/8/8/8/8/8 w - - 0 1", {6, 27, 273, 1329, 18135, 92683}},
+	// Checks, mates and stalemates
+	{"Discovered check", "8/8/1P2K3/8/2n5/1q6/8/5k2 b - - 0 1", {29, 165, 5160, 31961, 1004658}},
+	{"Self stalemate", "K1k5/8/P7/8/8/8/8/8 w - - 0 1", {2, 6, 13, 63, 382, 2217}},
+	{"Stalemate and checkmate", "8/k1P5/8/1K6/8/8/8/8 w - - 0 1", {10, 25, 268, 926, 10857, 43261, 567584}},
+	{"Stalemate and checkmate 2", "8/8/2k5/5q2/5n2/8/5K2/8 b - - 0 1", {37, 183, 6559, 23527}},
+};
+
+// Accepts only a whole number from 1 to 64, anything else would index the expected counts out of range
+static bool parseMaxDepth(const char *argument, int &value)
+{
+	char *end = nullptr;
+	long parsed = std::strtol(argument, &end, 10);
+	if (end == argument || *end != '\0' || parsed < 1 || parsed > 64)
+	{
+		return false;
+	}
+
+	value = static_cast<int>(parsed);
+	return true;
+}
+
+int main(int argc, char **argv)
+{
+	int maxDepth = 5;
+	if (argc > 1 && !parseMaxDepth(argv[1], maxDepth))
+	{
+		std::cerr << "Usage: " << argv[0] << " [max depth] - max depth must be a positive number\n";
+		return EXIT_FAILURE;
+	}
+
+	uint64_t totalNodes = 0;
+	double totalSeconds = 0;
+	bool allPassed = true;
+
+	std::cout << std::left << std::setw(44) << "Position" << std::right << std::setw(6) << "Depth" << std::setw(14) << "Nodes" << std::setw(11) << "Time (s)" << std::setw(14) << "NPS" << "\n";
+
+	for (const PerftSuitePosition &position : PERFT_SUITE)
+	{
+		int depth = std::min(maxDepth, static_cast<int>(position.expectedNodes.size()));
+		uint64_t expectedNodes = position.expectedNodes[depth - 1];
+
+		Game game(position.fen);
+		auto start = std::chrono::steady_clock::now();
+		uint64_t nodes = game.perft(depth);
+		double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		totalNodes += nodes;
+		totalSeconds += seconds;
+		allPassed &= nodes == expectedNodes;
+
+		std::cout << std::left << std::setw(44) << position.name << std::right << std::setw(6) << depth << std::setw(14) << nodes << std::setw(11) << std::fixed << std::setprecision(3) << seconds << std::setw(14) << static_cast<uint64_t>(seconds > 0 ? nodes / seconds : 0);
+		if (nodes != expectedNodes)
+		{
+			std::cout << "  MISMATCH, expected " << expectedNodes;
+		}
+		std::cout << "\n";
+	}
+
+	std::cout << std::left << std::setw(44) << "Total" << std::right << std::setw(6) << "" << std::setw(14) << totalNodes << std::setw(11) << totalSeconds << std::setw(14) << static_cast<uint64_t>(totalSeconds > 0 ? totalNodes / totalSeconds : 0) << "\n";
+
+	return allPassed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
\ No newline at end of file
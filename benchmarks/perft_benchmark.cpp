@@ -0,0 +1,73 @@
+#include <benchmark/benchmark.h>
+
+#include "../include/Game.hpp"
+
+static const std::string STARTING_POSITION = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+static const std::string KIWIPETE = "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1";
+// Closed middlegame with all sixteen pawns still on the board, where pawn moves are a large share of the work
+static const std::string PAWN_HEAVY = "r1bq1rk1/pp1nbppp/2p1pn2/3p4/2PP4/2N1PN2/PP1BBPPP/R2QK2R w KQ - 2 8";
+
+static void BM_GenerateLegalMoves(benchmark::State &state, std::string fen)
+{
+	Game game(fen);
+	MoveList moves;
+
+	for (auto _ : state)
+	{
+		game.generateLegalMoves(moves);
+		benchmark::DoNotOptimize(moves);
+	}
+}
+
+BENCHMARK_CAPTURE(BM_GenerateLegalMoves, StartingPosition, STARTING_POSITION);
+BENCHMARK_CAPTURE(BM_GenerateLegalMoves, Kiwipete, KIWIPETE);
+
+static void BM_Perft(benchmark::State &state, std::string fen)
+{
+	Game game(fen);
+	int depth = state.range(0);
+	uint64_t nodes = 0;
+
+	for (auto _ : state)
+	{
+		nodes = game.perft(depth);
+	}
+
+	state.counters["Nodes"] = nodes;
+	state.counters["NPS"] = benchmark::Counter(nodes * state.iterations(), benchmark::Counter::kIsRate);
+}
+
+// Depth 6 from the starting position is the reference number for move generator throughput, one iteration is plenty
+BENCHMARK_CAPTURE(BM_Perft, StartingPosition, STARTING_POSITION)->DenseRange(1, 5)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_Perft, StartingPosition, STARTING_POSITION)->Arg(6)->Iterations(1)->Unit(benchmark::kSecond);
+BENCHMARK_CAPTURE(BM_Perft, Kiwipete, KIWIPETE)->DenseRange(1, 4)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_Perft, PawnHeavy, PAWN_HEAVY)->DenseRange(1, 4)->Unit(benchmark::kMillisecond);
+
+static void BM_PerftParallel(benchmark::State &state, std::string fen)
+{
+	Game game(fen);
+	int depth = state.range(0);
+	int threadCount = state.range(1);
+	PerftResult result;
+
+	for (auto _ : state)
+	{
+		result = game.perftParallel(depth, threadCount);
+	}
+
+	// The slowest thread bounds the wall time, so its share shows how evenly the work was split
+	double slowestThread = 0;
+	for (const PerftThreadStats &thread : result.threads)
+	{
+		slowestThread = std::max(slowestThread, thread.seconds);
+	}
+
+	state.counters["Nodes"] = result.nodes;
+	state.counters["NPS"] = benchmark::Counter(result.nodes * state.iterations(), benchmark::Counter::kIsRate);
+	state.counters["SlowestThreadShare"] = result.seconds > 0 ? slowestThread / result.seconds : 0;
+}
+
+BENCHMARK_CAPTURE(BM_PerftParallel, StartingPosition, STARTING_POSITION)->ArgsProduct({{5}, {1, 2, 4, 8, 16, 32}})->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_CAPTURE(BM_PerftParallel, StartingPosition, STARTING_POSITION)->Args({6, 32})->Iterations(1)->Unit(benchmark::kSecond)->UseRealTime();
+
+BENCHMARK_MAIN();
\ No newline at end of file
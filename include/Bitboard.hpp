@@ -8,11 +8,15 @@
 class Bitboard
 {
 public:
-	Bitboard();
-	Bitboard(uint64_t value);
+	// Constexpr so the precomputed tables can be built at compile time
+	constexpr Bitboard() = default;
+	constexpr Bitboard(uint64_t value) : value(value) {}
 	Bitboard(Position position);
 
-	uint64_t getValue() const;
+	constexpr uint64_t getValue() const
+	{
+		return value;
+	}
 	void setValue(uint64_t value);
 
 	void setBit(int square);
@@ -1,9 +1,24 @@
 #ifndef EVALULATION_HPP
 #define EVALULATION_HPP
 
+#include <array>
+
+#include "Board.hpp"
+#include "enums/PieceType.hpp"
+
 class Evalulation
 {
 public:
+	// Material in centipawns indexed by piece type. The king is never traded, its value only has to outweigh every exchange
+	static constexpr std::array<int, 6> PIECE_VALUES = {100, 320, 330, 500, 900, 20000};
+
+	static constexpr int getPieceValue(PieceType piece)
+	{
+		return PIECE_VALUES[static_cast<int>(piece)];
+	}
+
+	// Static score of the position in centipawns, positive when it favours the given color
+	static int evaluate(Board &board, Color color);
 
 protected:
 
@@ -7,6 +7,10 @@
 
 #include "Board.hpp"
 #include "Move.hpp"
+#include "structs/MoveList.hpp"
+#include "structs/UndoInfo.hpp"
+#include "structs/PerftResult.hpp"
+#include "PerftCache.hpp"
 #include "enums/Color.hpp"
 #include "structs/CastleRights.hpp"
 
@@ -20,6 +24,7 @@ public:
 	void setActiveColor(Color activeColor);
 	Board &getBoard();
 	std::string getFen();
+	void setFen(std::string fen);
 	int getHalfMoveClock() const;
 	void setHalfMoveClock(int halfMoveClock);
 	int getFullMoveNumber() const;
@@ -27,42 +32,50 @@ public:
 	CastleRights getWhiteCastleRights() const;
 	CastleRights getBlackCastleRights() const;
 	Move getLastMove() const;
+	UndoInfo getLastUndoInfo() const;
+	uint64_t getZobristKey() const;
+	uint64_t computeZobristKey() const;
 
 	void makeMove(Position from, Position to, PromotionPiece promotionPiece);
 	void unmakeMove();
+	// Unchecked versions of makeMove and unmakeMove for moves already known to be legal, such as generated ones
+	void doMove(Move move);
+	void undoMove();
 	uint64_t perft(int depth);
-	void perftRoot(int depth, std::map<std::string, int> &output);
-	std::vector<Move> generateLegalMoves();
+	uint64_t perft(int depth, PerftCache &cache, PerftCacheStats &stats);
+	void perftRoot(int depth, std::map<std::string, uint64_t> &output);
+	// Splits the tree below the root across worker threads, each working on its own copy of the game
+	PerftResult perftParallel(int depth, int threadCount, PerftCache *cache = nullptr);
+	void generateLegalMoves(MoveList &moves);
+	// Long algebraic notation, promotions name the piece
+	std::string moveToString(Move move) const;
 
 	std::vector<std::string> getFenTokens(std::string fen);
 
 private:
 	Color activeColor;
 	Board board;
-	std::vector<Move> moveHistory;
+	std::vector<UndoInfo> moveHistory;
 	uint8_t halfMoveClock;
 	uint16_t fullMoveNumber;
 	CastleRights whiteCastleRights;
 	CastleRights blackCastleRights;
-	bool cachedInCheckValue;
-	bool hasCachedInCheckValue = false;
+	uint64_t zobristKey; // Side to move and castling rights, the board hashes the rest
 
+	void parseGameState(std::vector<std::string> &fenParts);
 	void parseActiveColor(std::string color);
 	void parsehalfMoveClock(std::string halfMoveClock);
 	void parseFullMoveNumber(std::string fullMoveNumber);
 	void parseCastlingRights(std::string castlingRights);
 	void switchActiveColor();
+	uint64_t computeStateZobristKey() const;
 	void incrementHalfMoveClock();
 	void incrementFullMoveNumber();
-	void addMoveToHistory(Move move);
+	void addMoveToHistory(UndoInfo undoInfo);
 	std::optional<PieceType> getCapturedPiece(PieceType piece, Position from, Position to);
 	SpecialMove getSpecialMove(PieceType piece, Position from, Position to, std::optional<PieceType> capturedPiece, PromotionPiece promotionPiece);
 	std::optional<Position> getEnPassantTargetSquare(PieceType piece, Position from, Position to, SpecialMove specialMove);
-	void updateCastlingRights(PieceType piece, Color color, Position from);
-	bool isInCheck();
-	bool isValidMove(Position from, Position to, PieceType piece);
-	bool movePutsKingInCheck(Position from, Position to, PieceType piece);
-	Move composeMove(Position from, Position to, PieceType piece, PromotionPiece promotionPiece, CastleRights whiteCastleRights, CastleRights blackCastleRights, int halfMoveClock, int fullMoveNumber);
+	void updateCastlingRights(PieceType piece, Color color, Position from, Position to);
 };
 
 #endif // GAME_HPP
\ No newline at end of file
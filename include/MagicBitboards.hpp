@@ -2,59 +2,26 @@
 #define MAGICBITBOARDS_HPP
 
 #include "Bitboard.hpp"
+#include "PrecomputedData.hpp"
 #include "enums/PieceType.hpp"
 
-#include <array>
-#include <vector>
-#include <mutex>
-
+// Slider attack lookups, the tables are generated at compile time in PrecomputedData so there is nothing to initialize
 class MagicBitboards
 {
 public:
-	static void init();
 	static Bitboard getSliderAttacks(int square, Bitboard occupied, PieceType pieceType);
+	static Bitboard getMagicSliderAttacks(int square, Bitboard occupied, PieceType pieceType);
+#ifdef USE_PEXT
+	static Bitboard getPextSliderAttacks(int square, Bitboard occupied, PieceType pieceType);
+#endif
 
 private:
-	static std::once_flag initFlag;
-
-	// Precomputed magic numbers for sliders
-	static std::array<uint64_t, 64> rookMagics;
-	static std::array<uint64_t, 64> bishopMagics;
-
-	// Precomputed shift values for sliders
-	static std::array<int, 64> rookShifts;
-	static std::array<int, 64> bishopShifts;
-
-	// Masks for the sliders
-	static std::array<uint64_t, 64> rookMasks;
-	static std::array<uint64_t, 64> bishopMasks;
-
-	// Attacks for the sliders
-	static std::array<std::array<uint64_t, 4096>, 64> rookAttacks;
-	static std::array<std::array<uint64_t, 512>, 64> bishopAttacks;
-
 	static Bitboard getRookAttacks(int square, Bitboard occupied);
 	static Bitboard getBishopAttacks(int square, Bitboard occupied);
-	static std::vector<uint64_t> createAllBlockerPatterns(uint64_t mask);
-	static uint64_t legalMovesFromBlockers(int square, uint64_t blockers, bool rook);
-
-	template<size_t N>
-	static std::array<uint64_t, N> createTable(int square, bool rook, uint64_t magic, int shift)
-	{
-		std::array<uint64_t, N> table = {};
-
-		uint64_t movementMask = rook ? rookMasks[square] : bishopMasks[square];
-		std::vector<uint64_t> blockerPatterns = createAllBlockerPatterns(movementMask);
-
-		for (uint64_t pattern : blockerPatterns)
-		{
-			uint64_t index = (pattern * magic) >> shift;
-			uint64_t moves = legalMovesFromBlockers(square, pattern, rook);
-			table[index] = moves;
-		}
-
-		return table;
-	}
+#ifdef USE_PEXT
+	static Bitboard getPextRookAttacks(int square, Bitboard occupied);
+	static Bitboard getPextBishopAttacks(int square, Bitboard occupied);
+#endif
 };
 
 #endif // MAGICBITBOARDS_HPP
\ No newline at end of file
@@ -0,0 +1,47 @@
+#ifndef MOVEGENERATOR_HPP
+#define MOVEGENERATOR_HPP
+
+#include "Game.hpp"
+#include "enums/GenType.hpp"
+#include "structs/CheckContext.hpp"
+#include "structs/LegalityContext.hpp"
+#include "structs/MoveList.hpp"
+
+// Legal move generation, instantiated per side and move class so colors and move filters are resolved at compile time
+class MoveGenerator
+{
+public:
+	static void generateLegalMoves(Game &game, MoveList &moves);
+
+	// Generates for the side to move
+	template <GenType Type>
+	static void generate(Game &game, MoveList &moves);
+
+	// Generates for the given side, which must be the side to move
+	template <Color Us, GenType Type>
+	static void generate(Game &game, MoveList &moves);
+
+private:
+	template <Color Us, GenType Type>
+	static void generatePawnMoves(Board &board, Bitboard opponentPieces, Bitboard occupied, const LegalityContext &context, MoveList &moves);
+	template <int Offset>
+	static uint64_t shiftBitboard(uint64_t bits);
+	template <int Offset>
+	static void addPawnMoves(uint64_t targets, SpecialMove specialMove, bool isCapture, const LegalityContext &context, MoveList &moves);
+	template <int Offset>
+	static void addPromotions(uint64_t targets, bool isCapture, const LegalityContext &context, MoveList &moves);
+	template <Color Us, PieceType Piece>
+	static void generatePieceMoves(Board &board, Bitboard targets, Bitboard opponentPieces, Bitboard occupied, const LegalityContext &context, MoveList &moves);
+	template <Color Us>
+	static void generateKingMoves(Board &board, Bitboard targets, Bitboard opponentPieces, const LegalityContext &context, MoveList &moves);
+	template <Color Us>
+	static void generateCastlingMoves(Game &game, Bitboard occupied, Bitboard opponentAttacks, MoveList &moves);
+	template <Color Us>
+	static void generateQuietChecks(Game &game, MoveList &moves);
+
+	static void addMoves(int from, Bitboard targets, Bitboard opponentPieces, MoveList &moves);
+	static bool leavesKingInCheck(Board &board, Move move, Color friendlyColor);
+	static bool castlingGivesCheck(Board &board, Move move, Color friendlyColor);
+};
+
+#endif // MOVEGENERATOR_HPP
\ No newline at end of file
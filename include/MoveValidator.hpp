@@ -2,13 +2,19 @@
 #define MOVEVALIDATOR_HPP
 
 #include "Game.hpp"
+#include "structs/CheckContext.hpp"
+#include "structs/LegalityContext.hpp"
 
 class MoveValidator
 {
 public:
 	static void validateMove(Position from, Position to, PieceType piece, Color friendlyColor, Game &game);
 	static bool isSquareAttacked(Board &board, Color friendlyColor, int square);
+	static bool isSquareAttacked(Board &board, Color friendlyColor, int square, Bitboard occupied);
+	static Bitboard getAttackedSquares(Board &board, Color attackingColor, Bitboard occupied);
 	static Bitboard findAbsolutePins(Board &board, Color friendlyColor);
+	static LegalityContext createLegalityContext(Board &board, Color friendlyColor);
+	static CheckContext createCheckContext(Board &board, Color friendlyColor);
 	static Bitboard generatePotentialMoves(Position position, PieceType piece, Color friendlyColor, Board &board);
 
 private:
@@ -24,6 +30,7 @@ private:
 
 	static Bitboard xrayAttacks(Bitboard occupied, Bitboard friendlyPieces, int kingSquare, PieceType piece);
 	static Bitboard getObstructedRay(Bitboard ray, Bitboard occupied);
+	static void addPins(Board &board, Bitboard pinners, Bitboard occupied, Bitboard friendlyPieces, int kingSquare, LegalityContext &context);
 };
 
 #endif // MOVEVALIDATOR_HPP
\ No newline at end of file
@@ -0,0 +1,38 @@
+#ifndef PERFTCACHE_HPP
+#define PERFTCACHE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+// Fixed size table of perft subtree counts keyed by position hash and remaining depth, shared by perft threads without locks.
+// Each entry stores its key XORed with its data, so an entry torn by two threads writing at once fails validation instead of returning a wrong count
+class PerftCache
+{
+public:
+	PerftCache(size_t megabytes);
+
+	bool probe(uint64_t key, int depth, uint64_t &nodes) const;
+	void store(uint64_t key, int depth, uint64_t nodes);
+	void clear();
+	size_t getEntryCount() const;
+
+private:
+	struct Entry
+	{
+		std::atomic<uint64_t> validation{0}; // Key XOR data
+		std::atomic<uint64_t> data{0};		 // Node count in the upper 56 bits, depth in the lower 8
+	};
+
+	std::unique_ptr<Entry[]> entries;
+	size_t entryCount;
+};
+
+// Probe counts kept by each perft thread and summed afterwards, so the hot path never touches shared counters
+struct PerftCacheStats
+{
+	uint64_t probes = 0;
+	uint64_t hits = 0;
+};
+
+#endif // PERFTCACHE_HPP
\ No newline at end of file
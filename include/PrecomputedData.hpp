@@ -2,10 +2,17 @@
 #define PRECOMPUTEDDATA_HPP
 
 #include "Bitboard.hpp"
+#include "structs/SliderMagic.hpp"
 
 #include <array>
 #include <cstdint>
 
+// Builds targeting BMI2 (-mbmi2, -march=native) index the slider tables with PEXT, others fall back to magics
+#if defined(__BMI2__) && !defined(NO_PEXT)
+#define USE_PEXT
+#include <immintrin.h>
+#endif
+
 namespace PrecomputedData
 {
 	// Precomputed magic numbers
@@ -17,18 +24,30 @@ namespace PrecomputedData
 	// Precomputed masks
 	extern const std::array<uint64_t, 64> rookMasks;
 	extern const std::array<uint64_t, 64> bishopMasks;
-	// // Precomputed rook attacks
-	// extern const std::array<std::array<Bitboard, 4096>, 64> rookAttacks;
-	// // Precomputed bishop attacks
-	// extern const std::array<std::array<Bitboard, 512>, 64> bishopAttacks;
+	// Precomputed slider attacks, each square owning a slice sized to the 2^(64 - shift) entries its magic can index
+	constexpr int ROOK_TABLE_SIZE = 102400;
+	constexpr int BISHOP_TABLE_SIZE = 5104;
+	extern const std::array<uint64_t, ROOK_TABLE_SIZE> rookAttacks;
+	extern const std::array<uint64_t, BISHOP_TABLE_SIZE> bishopAttacks;
+	extern const std::array<SliderMagic, 64> rookSliderMagics;
+	extern const std::array<SliderMagic, 64> bishopSliderMagics;
+#ifdef USE_PEXT
+	// Precomputed slider attacks indexed by PEXT, each square owning 2^(mask bits) entries starting at its offset
+	constexpr int ROOK_PEXT_TABLE_SIZE = 102400;
+	constexpr int BISHOP_PEXT_TABLE_SIZE = 5248;
+	extern const std::array<uint64_t, ROOK_PEXT_TABLE_SIZE> rookPextAttacks;
+	extern const std::array<uint64_t, BISHOP_PEXT_TABLE_SIZE> bishopPextAttacks;
+	extern const std::array<uint32_t, 64> rookPextOffsets;
+	extern const std::array<uint32_t, 64> bishopPextOffsets;
+#endif
 	// Precomputed pawn attacks
 	extern const std::array<std::array<Bitboard, 64>, 2> pawnAttacks;
 	// Precomputed knight attacks
 	extern const std::array<Bitboard, 64> knightAttacks;
 	// Precomputed king attacks
 	extern const std::array<Bitboard, 64> kingAttacks;
-	// // Precomputed rays
-	// extern const std::array<std::array<Bitboard, 64>, 64> rays;
+	// Precomputed rays, the squares strictly between two squares sharing a line and empty otherwise
+	extern const std::array<std::array<Bitboard, 64>, 64> rays;
 }
 
 #endif // PRECOMPUTEDDATA_HPP
\ No newline at end of file
@@ -1,14 +1,61 @@
 #ifndef SEARCH_HPP
 #define SEARCH_HPP
 
+#include <array>
+#include <chrono>
+#include <functional>
+#include <memory>
+
+#include "Game.hpp"
+#include "structs/MoveList.hpp"
+#include "structs/SearchInfo.hpp"
+#include "structs/SearchLimits.hpp"
+
+// Negamax alpha-beta with iterative deepening and a capture-only quiescence search at the leaves.
+// Moves are played on the given game and always taken back, every per-ply buffer lives in a stack allocated once up front
 class Search
 {
 public:
+	static constexpr int MAX_PLY = 64;
+	static constexpr int INFINITE_SCORE = 32000;
+	static constexpr int MATE_SCORE = 31000; // Mate in n plies scores MATE_SCORE - n
+
+	using Reporter = std::function<void(const SearchInfo &info)>;
 
-protected:
+	Search(Game &game);
+
+	// The reporter is called after every completed iteration, the returned info is the last of them
+	SearchInfo run(const SearchLimits &limits, Reporter reporter = nullptr);
 
 private:
+	struct StackEntry
+	{
+		MoveList moves;
+		std::array<Move, MAX_PLY> principalVariation;
+		int principalVariationLength;
+		uint64_t zobristKey;
+		bool onPreviousPrincipalVariation; // Reached by following the last iteration's line from the root
+	};
+
+	Game &game;
+	std::unique_ptr<StackEntry[]> stack;
+	SearchLimits limits;
+	std::chrono::steady_clock::time_point startTime;
+	uint64_t nodes;
+	bool stopped;
+	bool canStop; // Off during the first iteration
+	std::array<Move, MAX_PLY> previousPrincipalVariation;
+	int previousPrincipalVariationLength;
 
+	int negamax(int depth, int ply, int alpha, int beta);
+	int quiescence(int ply, int alpha, int beta);
+	void scoreMoves(MoveList &moves, int ply);
+	Move pickMove(MoveList &moves, int index);
+	void updatePrincipalVariation(int ply, Move move);
+	bool isDraw(int ply);
+	bool isInCheck();
+	bool shouldStop();
+	double getElapsedSeconds() const;
 };
 
 #endif // SEARCH_HPP
\ No newline at end of file
@@ -0,0 +1,30 @@
+#ifndef STATICEXCHANGE_HPP
+#define STATICEXCHANGE_HPP
+
+#include "Board.hpp"
+
+// Static exchange evaluation: the material outcome of the capture sequence on a move's target square when both sides
+// recapture with their least valuable attacker and may stop whenever continuing loses. Nothing is played on the board,
+// sliders lined up behind a used attacker join the exchange as it is removed from the occupancy. Pins are not considered
+class StaticExchange
+{
+public:
+	// Material won by the side making the move, in centipawns
+	static int see(Board &board, Move move);
+	// Whether the exchange wins at least the threshold, stopping as soon as the outcome is decided
+	static bool seeGE(Board &board, Move move, int threshold);
+
+private:
+	struct Exchange
+	{
+		Color color;
+		int gain;		   // Material taken by the move itself, promotion included
+		int attackerValue; // Value of the piece left standing on the target square
+		Bitboard occupied; // Occupancy after the move, the captured piece and the moving piece taken off
+	};
+
+	static Exchange createExchange(Board &board, Move move);
+	static bool popLeastValuableAttacker(Board &board, Color color, int to, Bitboard &attackers, Bitboard &occupied, int &value);
+};
+
+#endif // STATICEXCHANGE_HPP
\ No newline at end of file
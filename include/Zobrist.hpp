@@ -0,0 +1,31 @@
+#ifndef ZOBRIST_HPP
+#define ZOBRIST_HPP
+
+#include "enums/PieceType.hpp"
+#include "enums/Color.hpp"
+#include "structs/CastleRights.hpp"
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+
+// Random keys for hashing positions, a position's key is the XOR of the keys of everything in it
+class Zobrist
+{
+public:
+	static void init();
+	static uint64_t getPieceKey(PieceType piece, Color color, int square);
+	static uint64_t getSideToMoveKey();
+	static uint64_t getCastlingKey(CastleRights whiteCastleRights, CastleRights blackCastleRights);
+	static uint64_t getEnPassantKey(int file);
+
+private:
+	static std::once_flag initFlag;
+
+	static std::array<std::array<std::array<uint64_t, 64>, 6>, 2> pieceKeys;
+	static uint64_t sideToMoveKey;
+	static std::array<uint64_t, 16> castlingKeys; // One per combination of the four castling rights
+	static std::array<uint64_t, 8> enPassantKeys;
+};
+
+#endif // ZOBRIST_HPP
\ No newline at end of file
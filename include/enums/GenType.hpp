@@ -0,0 +1,14 @@
+#ifndef GENTYPE_HPP
+#define GENTYPE_HPP
+
+// Which class of legal moves a generator call produces. Captures and quiets split every legal move between them
+enum class GenType
+{
+	CAPTURES = 0,	  // Captures, en passant and every promotion
+	QUIETS = 1,		  // Everything else, including castling
+	EVASIONS = 2,	  // Every legal move while in check
+	QUIET_CHECKS = 3, // Quiets that give check
+	ALL = 4
+};
+
+#endif // GENTYPE_HPP
\ No newline at end of file
@@ -0,0 +1,26 @@
+#ifndef CHECKCONTEXT_HPP
+#define CHECKCONTEXT_HPP
+
+#include <array>
+
+#include "../Bitboard.hpp"
+#include "../enums/PieceType.hpp"
+
+// Everything needed to tell whether a move checks the opponent king without playing it
+struct CheckContext
+{
+	// For each piece type, the squares it would attack the opponent king from
+	std::array<Bitboard, 6> checkSquares;
+	// Friendly pieces alone between a friendly slider and the opponent king
+	Bitboard discoverers;
+	// For each discoverer, the squares between the slider and the king plus the slider itself
+	std::array<Bitboard, 64> discoveryRays;
+
+	// Castling is not covered, the rook's check depends on where the king ends up
+	bool givesCheck(PieceType piece, int from, int to) const
+	{
+		return checkSquares[static_cast<int>(piece)].getBit(to) || (discoverers.getBit(from) && !discoveryRays[from].getBit(to));
+	}
+};
+
+#endif // CHECKCONTEXT_HPP
\ No newline at end of file
@@ -0,0 +1,39 @@
+#ifndef LEGALITYCONTEXT_HPP
+#define LEGALITYCONTEXT_HPP
+
+#include <array>
+
+#include "../Bitboard.hpp"
+
+// Everything needed to filter pseudo-legal moves for one position, computed once per node
+struct LegalityContext
+{
+	// Opponent pieces giving check to the friendly king
+	Bitboard checkers;
+	// Friendly pieces absolutely pinned to their king
+	Bitboard pinned;
+	// Squares a non-king move must land on to answer a single check, every square when not in check
+	Bitboard checkMask = ~Bitboard(0);
+	// For each pinned piece, the squares between the pinner and the king plus the pinner itself
+	std::array<Bitboard, 64> pinRays;
+	// Squares attacked by the opponent with the friendly king taken off the board, the king may not move onto any of them
+	Bitboard opponentAttacks;
+
+	bool isInCheck() const
+	{
+		return checkers.getValue() != 0;
+	}
+
+	bool isDoubleCheck() const
+	{
+		return (checkers.getValue() & (checkers.getValue() - 1)) != 0;
+	}
+
+	// Squares the piece on the given square may move to without exposing the king or ignoring a check
+	Bitboard getAllowedTargets(int square) const
+	{
+		return pinned.getBit(square) ? checkMask & pinRays[square] : checkMask;
+	}
+};
+
+#endif // LEGALITYCONTEXT_HPP
\ No newline at end of file
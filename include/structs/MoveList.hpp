@@ -0,0 +1,80 @@
+#ifndef MOVELIST_HPP
+#define MOVELIST_HPP
+
+#include <array>
+
+#include "../Move.hpp"
+
+// Fixed capacity list of moves stored inline, so generating moves never touches the heap.
+// 256 entries is above the largest known number of legal moves in a position (218)
+struct MoveList
+{
+	static constexpr int MAX_MOVES = 256;
+
+	std::array<Move, MAX_MOVES> moves;
+	std::array<int, MAX_MOVES> scores; // Optional ordering score per move, only meaningful once set
+	int count = 0;
+
+	void addMove(Move move)
+	{
+		moves[count] = move;
+		count++;
+	}
+
+	void clear()
+	{
+		count = 0;
+	}
+
+	int size() const
+	{
+		return count;
+	}
+
+	bool empty() const
+	{
+		return count == 0;
+	}
+
+	int getScore(int index) const
+	{
+		return scores[index];
+	}
+
+	void setScore(int index, int score)
+	{
+		scores[index] = score;
+	}
+
+	Move &operator[](int index)
+	{
+		return moves[index];
+	}
+
+	const Move &operator[](int index) const
+	{
+		return moves[index];
+	}
+
+	Move *begin()
+	{
+		return moves.data();
+	}
+
+	Move *end()
+	{
+		return moves.data() + count;
+	}
+
+	const Move *begin() const
+	{
+		return moves.data();
+	}
+
+	const Move *end() const
+	{
+		return moves.data() + count;
+	}
+};
+
+#endif // MOVELIST_HPP
\ No newline at end of file
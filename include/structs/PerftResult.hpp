@@ -0,0 +1,41 @@
+#ifndef PERFTRESULT_HPP
+#define PERFTRESULT_HPP
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+// Work done by one worker of a parallel perft
+struct PerftThreadStats
+{
+	uint64_t nodes = 0;
+	double seconds = 0;
+
+	double getNodesPerSecond() const
+	{
+		return seconds > 0 ? nodes / seconds : 0;
+	}
+};
+
+struct PerftResult
+{
+	uint64_t nodes = 0;
+	double seconds = 0;
+	std::map<std::string, uint64_t> rootMoveNodes;
+	std::vector<PerftThreadStats> threads;
+	uint64_t cacheProbes = 0; // Zero when perft ran without a cache
+	uint64_t cacheHits = 0;
+
+	double getNodesPerSecond() const
+	{
+		return seconds > 0 ? nodes / seconds : 0;
+	}
+
+	double getCacheHitRate() const
+	{
+		return cacheProbes > 0 ? static_cast<double>(cacheHits) / cacheProbes : 0;
+	}
+};
+
+#endif // PERFTRESULT_HPP
\ No newline at end of file
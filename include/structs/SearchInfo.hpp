@@ -0,0 +1,24 @@
+#ifndef SEARCHINFO_HPP
+#define SEARCHINFO_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "../Move.hpp"
+
+// Outcome of one completed iterative deepening iteration, scores are in centipawns from the side to move's point of view
+struct SearchInfo
+{
+	int depth = 0;
+	int score = 0;
+	uint64_t nodes = 0; // Counted over every iteration so far
+	double seconds = 0;
+	std::vector<Move> principalVariation; // Empty when the side to move has no legal move
+
+	double getNodesPerSecond() const
+	{
+		return seconds > 0 ? nodes / seconds : 0;
+	}
+};
+
+#endif // SEARCHINFO_HPP
\ No newline at end of file
@@ -0,0 +1,14 @@
+#ifndef SEARCHLIMITS_HPP
+#define SEARCHLIMITS_HPP
+
+#include <cstdint>
+
+// When iterative deepening stops, whichever limit is hit first. The first iteration always completes so a move is known
+struct SearchLimits
+{
+	int depth = 64;			  // Deepest iteration, capped at the search stack size
+	uint64_t nodes = 0;		  // Zero for no node limit
+	int64_t milliseconds = 0; // Zero for no time limit
+};
+
+#endif // SEARCHLIMITS_HPP
\ No newline at end of file
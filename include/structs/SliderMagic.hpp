@@ -0,0 +1,20 @@
+#ifndef SLIDERMAGIC_HPP
+#define SLIDERMAGIC_HPP
+
+#include <cstdint>
+
+// Everything a magic lookup needs for one square, aligned so it never straddles two cache lines
+struct alignas(32) SliderMagic
+{
+	const uint64_t *attacks; // This square's slice of the packed attack table
+	uint64_t mask;
+	uint64_t magic;
+	unsigned int shift;
+
+	unsigned int getIndex(uint64_t occupied) const
+	{
+		return ((occupied & mask) * magic) >> shift;
+	}
+};
+
+#endif // SLIDERMAGIC_HPP
\ No newline at end of file
@@ -0,0 +1,23 @@
+#ifndef UNDOINFO_HPP
+#define UNDOINFO_HPP
+
+#include <optional>
+#include <cstdint>
+
+#include "Position.hpp"
+#include "CastleRights.hpp"
+#include "../Move.hpp"
+#include "../enums/PieceType.hpp"
+
+// The state a move destroys and that cannot be recomputed when taking it back, one entry per move played
+struct UndoInfo
+{
+	Move move;
+	std::optional<PieceType> capturedPiece;
+	std::optional<Position> enPassantTargetSquare;
+	CastleRights whiteCastleRights;
+	CastleRights blackCastleRights;
+	uint8_t halfMoveClock;
+};
+
+#endif // UNDOINFO_HPP
\ No newline at end of file
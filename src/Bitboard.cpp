@@ -1,16 +1,6 @@
 #include "../include/Bitboard.hpp"
 #include "../include/Utility.hpp"
 
-Bitboard::Bitboard()
-{
-	value = 0x0ULL;
-}
-
-Bitboard::Bitboard(uint64_t value)
-{
-	this->value = value;
-}
-
 Bitboard::Bitboard(Position position)
 {
 	Utility::validatePosition(position);
@@ -18,11 +8,6 @@ Bitboard::Bitboard(Position position)
 	value = 0x1ULL << Utility::calculateSquareNumber(position);
 }
 
-uint64_t Bitboard::getValue() const
-{
-	return value;
-}
-
 void Bitboard::setValue(uint64_t value)
 {
 	this->value = value;
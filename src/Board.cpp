@@ -2,16 +2,30 @@
 #include "../include/Utility.hpp"
 #include "../include/PrecomputedData.hpp"
 
+#include <algorithm>
 #include <map>
+#include <stdexcept>
 
 Board::Board(std::string fenPosition, std::string fenEnPassantTargetSquare)
 {
-	initializePieceLists();
-	initializeAttacks();
-	initializeRays();
-	MagicBitboards::init();
+	Zobrist::init();
+	setPosition(fenPosition, fenEnPassantTargetSquare);
+}
+
+void Board::setPosition(std::string fenPosition, std::string fenEnPassantTargetSquare)
+{
+	// Everything is cleared in place, so a board can be reused for many positions
+	for (auto &bitboards : pieceBitboards)
+	{
+		bitboards.fill(Bitboard(0));
+	}
+	colorBitboards.fill(Bitboard(0));
+	occupiedBitboard = Bitboard(0);
+	mailbox.fill(EMPTY_SQUARE);
+
 	parseFenPosition(fenPosition);
 	parseFenEnPassantTargetSquare(fenEnPassantTargetSquare);
+	zobristKey = computeZobristKey();
 }
 
 Bitboard Board::getPieceBitboard(PieceType piece, Color color) const
@@ -19,24 +33,14 @@ Bitboard Board::getPieceBitboard(PieceType piece, Color color) const
 	return pieceBitboards[static_cast<int>(color)][static_cast<int>(piece)];
 }
 
-void Board::setPieceBitboard(PieceType piece, Color color, Bitboard bitboard)
-{
-	pieceBitboards[static_cast<int>(color)][static_cast<int>(piece)] = bitboard;
-}
-
 Bitboard Board::getColorBitboard(Color color) const
 {
-	Bitboard colorBitboard = Bitboard(0);
-	for (PieceType piece : {PieceType::PAWN, PieceType::KNIGHT, PieceType::BISHOP, PieceType::ROOK, PieceType::QUEEN, PieceType::KING})
-	{
-		colorBitboard |= getPieceBitboard(piece, color);
-	}
-	return colorBitboard;
+	return colorBitboards[static_cast<int>(color)];
 }
 
 Bitboard Board::getOccupiedBitboard() const
 {
-	return getColorBitboard(Color::WHITE) | getColorBitboard(Color::BLACK);
+	return occupiedBitboard;
 }
 
 std::optional<Position> Board::getEnPassantTargetSquare() const
@@ -46,149 +50,118 @@ std::optional<Position> Board::getEnPassantTargetSquare() const
 
 void Board::setEnPassantTargetSquare(std::optional<Position> enPassantTargetSquare)
 {
+	if (this->enPassantTargetSquare.has_value())
+	{
+		zobristKey ^= Zobrist::getEnPassantKey(this->enPassantTargetSquare.value().col);
+	}
+	if (enPassantTargetSquare.has_value())
+	{
+		zobristKey ^= Zobrist::getEnPassantKey(enPassantTargetSquare.value().col);
+	}
+
 	this->enPassantTargetSquare = enPassantTargetSquare;
 }
 
-PieceList Board::getPieceList(PieceType piece, Color color) const
+int Board::getKing(Color color) const
 {
-	switch (piece)
-	{
-		case PieceType::PAWN:
-			return getPawns(color);
-		case PieceType::KNIGHT:
-			return getKnights(color);
-		case PieceType::BISHOP:
-			return getBishops(color);
-		case PieceType::ROOK:
-			return getRooks(color);
-		case PieceType::QUEEN:
-			return getQueens(color);
-		default:
-			return PieceList(0);
-	}
+	// Every valid position has exactly one king per side
+	return __builtin_ctzll(getPieceBitboard(PieceType::KING, color).getValue());
 }
 
-void Board::setPieceList(PieceType piece, Color color, PieceList pieceList)
+Bitboard Board::getAttacks(PieceType piece, Color color, int square) const
 {
 	switch (piece)
 	{
 		case PieceType::PAWN:
-			setPawns(color, pieceList);
-			break;
+			return PrecomputedData::pawnAttacks[static_cast<int>(color)][square];
 		case PieceType::KNIGHT:
-			setKnights(color, pieceList);
-			break;
+			return PrecomputedData::knightAttacks[square];
 		case PieceType::BISHOP:
-			setBishops(color, pieceList);
-			break;
+			return MagicBitboards::getSliderAttacks(square, getOccupiedBitboard(), PieceType::BISHOP);
 		case PieceType::ROOK:
-			setRooks(color, pieceList);
-			break;
+			return MagicBitboards::getSliderAttacks(square, getOccupiedBitboard(), PieceType::ROOK);
 		case PieceType::QUEEN:
-			setQueens(color, pieceList);
-			break;
+			return MagicBitboards::getSliderAttacks(square, getOccupiedBitboard(), PieceType::QUEEN);
+		case PieceType::KING:
+			return PrecomputedData::kingAttacks[square];
 		default:
-			break;
+			return Bitboard(0);
 	}
 }
 
-PieceList Board::getPawns(Color color) const
-{
-	return pawns[static_cast<int>(color)];
-}
-
-void Board::setPawns(Color color, PieceList pawns)
-{
-	this->pawns[static_cast<int>(color)] = pawns;
-}
-
-PieceList Board::getKnights(Color color) const
-{
-	return knights[static_cast<int>(color)];
-}
-
-void Board::setKnights(Color color, PieceList knights)
-{
-	this->knights[static_cast<int>(color)] = knights;
-}
-
-PieceList Board::getBishops(Color color) const
-{
-	return bishops[static_cast<int>(color)];
-}
-
-void Board::setBishops(Color color, PieceList bishops)
+Bitboard Board::attackersTo(int square, Bitboard occupied) const
 {
-	this->bishops[static_cast<int>(color)] = bishops;
-}
-
-PieceList Board::getRooks(Color color) const
-{
-	return rooks[static_cast<int>(color)];
-}
-
-void Board::setRooks(Color color, PieceList rooks)
-{
-	this->rooks[static_cast<int>(color)] = rooks;
-}
+	// Pieces of both colors that attack the square, sliders see through whatever is missing from the occupancy.
+	// Pieces themselves are not filtered by the occupancy, callers that remove attackers mask them out
+	const std::array<Bitboard, 6> &white = pieceBitboards[static_cast<int>(Color::WHITE)];
+	const std::array<Bitboard, 6> &black = pieceBitboards[static_cast<int>(Color::BLACK)];
+	auto both = [&](PieceType piece)
+	{
+		return white[static_cast<int>(piece)].getValue() | black[static_cast<int>(piece)].getValue();
+	};
+	uint64_t queens = both(PieceType::QUEEN);
 
-PieceList Board::getQueens(Color color) const
-{
-	return queens[static_cast<int>(color)];
-}
+	// Pawns attack the square from where a pawn of the other color on it would attack
+	uint64_t attackers = (PrecomputedData::pawnAttacks[static_cast<int>(Color::BLACK)][square].getValue() & white[static_cast<int>(PieceType::PAWN)].getValue())
+		| (PrecomputedData::pawnAttacks[static_cast<int>(Color::WHITE)][square].getValue() & black[static_cast<int>(PieceType::PAWN)].getValue())
+		| (PrecomputedData::knightAttacks[square].getValue() & both(PieceType::KNIGHT))
+		| (PrecomputedData::kingAttacks[square].getValue() & both(PieceType::KING))
+		| (MagicBitboards::getSliderAttacks(square, occupied, PieceType::ROOK).getValue() & (both(PieceType::ROOK) | queens))
+		| (MagicBitboards::getSliderAttacks(square, occupied, PieceType::BISHOP).getValue() & (both(PieceType::BISHOP) | queens));
 
-void Board::setQueens(Color color, PieceList queens)
-{
-	this->queens[static_cast<int>(color)] = queens;
+	return Bitboard(attackers);
 }
 
-int Board::getKing(Color color) const
+Bitboard Board::getRay(int from, int to) const
 {
-	return kings[static_cast<int>(color)];
+	return PrecomputedData::rays[from][to];
 }
 
-void Board::setKing(Color color, int king)
+std::optional<PieceType> Board::getPiece(Position position, Color color) const
 {
-	kings[static_cast<int>(color)] = king;
+	return getPiece(Utility::calculateSquareNumber(position), color);
 }
 
-Bitboard Board::getAttacks(PieceType piece, Color color, int square) const
+std::optional<PieceType> Board::getPiece(int square, Color color) const
 {
-	switch (piece)
+	// Each mailbox entry holds the piece type in the low three bits and the color above them
+	uint8_t content = mailbox[square];
+	if (content == EMPTY_SQUARE || static_cast<Color>(content >> 3) != color)
 	{
-		case PieceType::PAWN:
-			return pawnAttacks[static_cast<int>(color)][square];
-		case PieceType::KNIGHT:
-			return knightAttacks[square];
-		case PieceType::BISHOP:
-			return MagicBitboards::getSliderAttacks(square, getOccupiedBitboard(), PieceType::BISHOP);
-		case PieceType::ROOK:
-			return MagicBitboards::getSliderAttacks(square, getOccupiedBitboard(), PieceType::ROOK);
-		case PieceType::QUEEN:
-			return MagicBitboards::getSliderAttacks(square, getOccupiedBitboard(), PieceType::QUEEN);
-		case PieceType::KING:
-			return kingAttacks[square];
-		default:
-			return Bitboard(0);
+		return std::nullopt;
 	}
+
+	return static_cast<PieceType>(content & 0x7);
 }
 
-Bitboard Board::getRay(int from, int to) const
+uint64_t Board::getZobristKey() const
 {
-	return rays[from][to];
+	return zobristKey;
 }
 
-std::optional<PieceType> Board::getPiece(Position position, Color color) const
+uint64_t Board::computeZobristKey() const
 {
-	for (PieceType piece : {PieceType::PAWN, PieceType::KNIGHT, PieceType::BISHOP, PieceType::ROOK, PieceType::QUEEN, PieceType::KING})
+	uint64_t key = 0;
+	for (Color color : {Color::WHITE, Color::BLACK})
 	{
-		if (getPieceBitboard(piece, color).getBit(position))
+		for (PieceType piece : {PieceType::PAWN, PieceType::KNIGHT, PieceType::BISHOP, PieceType::ROOK, PieceType::QUEEN, PieceType::KING})
 		{
-			return piece;
+			Bitboard pieces = getPieceBitboard(piece, color);
+			while (pieces.getValue())
+			{
+				int square = pieces.bitScanForward();
+				pieces.clearBit(square);
+				key ^= Zobrist::getPieceKey(piece, color, square);
+			}
 		}
 	}
 
-	return std::nullopt;
+	if (enPassantTargetSquare.has_value())
+	{
+		key ^= Zobrist::getEnPassantKey(enPassantTargetSquare.value().col);
+	}
+
+	return key;
 }
 
 std::string Board::boardToAscii() const
@@ -204,17 +177,10 @@ std::string Board::boardToAscii() const
         for (int col = 0; col < 8; col++)
         {
             char pieceChar = ' ';
-            for (Color color : {Color::WHITE, Color::BLACK})
+            uint8_t content = mailbox[row * 8 + col];
+            if (content != EMPTY_SQUARE)
             {
-                for (PieceType piece : {PieceType::PAWN, PieceType::KNIGHT, PieceType::BISHOP, PieceType::ROOK, PieceType::QUEEN, PieceType::KING})
-                {
-                    if (getPieceBitboard(piece, color).getBit(Position{row, col}))
-                    {
-                        pieceChar = pieceToChar(piece, color);
-                        break;
-                    }
-                }
-                if (pieceChar != ' ') break;
+                pieceChar = pieceToChar(static_cast<PieceType>(content & 0x7), static_cast<Color>(content >> 3));
             }
             asciiBoard += pieceChar;
             asciiBoard += " | ";
@@ -242,17 +208,10 @@ std::string Board::getFenPosition() const
 		for (int col = 0; col < 8; col++)
 		{
 			char pieceChar = ' ';
-			for (Color color : {Color::WHITE, Color::BLACK})
+			uint8_t content = mailbox[row * 8 + col];
+			if (content != EMPTY_SQUARE)
 			{
-				for (PieceType piece : {PieceType::PAWN, PieceType::KNIGHT, PieceType::BISHOP, PieceType::ROOK, PieceType::QUEEN, PieceType::KING})
-				{
-					if (getPieceBitboard(piece, color).getBit(Position{row, col}))
-					{
-						pieceChar = pieceToChar(piece, color);
-						break;
-					}
-				}
-				if (pieceChar != ' ') break;
+				pieceChar = pieceToChar(static_cast<PieceType>(content & 0x7), static_cast<Color>(content >> 3));
 			}
 
 			if (pieceChar == ' ')
@@ -296,47 +255,69 @@ std::string Board::getFenEnPassantTargetSquare() const
 	}
 }
 
-void Board::movePiece(Move move)
+std::optional<PieceType> Board::movePiece(Move move, Color color)
 {
+	// The en passant target square only lasts for a single move, the previous value is kept in the undo info
+	setEnPassantTargetSquare(std::nullopt);
+
 	// Clear the piece bitboard from the from square
 	Position from = move.getFrom();
-	PieceType piece = move.getPieceType();
-	Color color = move.getColor();
-	setPieceBitboard(piece, color, getPieceBitboard(piece, color) & ~Bitboard(from));
+	PieceType piece = getPiece(from, color).value();
+	PieceType landingPiece = piece;
+	togglePiece(piece, color, Bitboard(from));
+	clearSquare(Utility::calculateSquareNumber(from));
 
-	// Set the piece bitboard on the to square and update the piece list
+	// Find the captured piece before the moving piece lands on the to square
 	Position to = move.getTo();
 	SpecialMove specialMove = move.getSpecialMove();
-	if (specialMove == SpecialMove::PROMOTION)
+	Color capturedPieceColor = color == Color::WHITE ? Color::BLACK : Color::WHITE;
+	std::optional<PieceType> capturedPiece = std::nullopt;
+	Position capturedPiecePosition = to;
+	if (specialMove == SpecialMove::EN_PASSANT)
+	{
+		capturedPiece = PieceType::PAWN;
+		capturedPiecePosition = Position{to.row + (color == Color::WHITE ? 1 : -1), to.col};
+	}
+	else if (move.isCapture())
+	{
+		capturedPiece = getPiece(to, capturedPieceColor);
+	}
+
+	// Remove the captured piece first, clearing its mailbox square after the moving piece lands would wipe the mover
+	if (capturedPiece.has_value())
 	{
-		// Remove the pawn from the piece list
-		pawns[static_cast<int>(color)].removePiece(Utility::calculateSquareNumber(from));
+		togglePiece(capturedPiece.value(), capturedPieceColor, Bitboard(capturedPiecePosition));
+		clearSquare(Utility::calculateSquareNumber(capturedPiecePosition));
+	}
 
-		// Add the promoted piece to the piece list and set the piece bitboard
+	// Set the piece bitboard on the to square
+	if (specialMove == SpecialMove::PROMOTION)
+	{
+		// The pawn is already gone from the from square, the promoted piece lands in its place
 		switch (move.getPromotionPiece())
 		{
 			case PromotionPiece::QUEEN:
 			{
-				queens[static_cast<int>(color)].addPiece(Utility::calculateSquareNumber(to));
-				setPieceBitboard(PieceType::QUEEN, color, getPieceBitboard(PieceType::QUEEN, color) | Bitboard(to));
+				landingPiece = PieceType::QUEEN;
+				togglePiece(PieceType::QUEEN, color, Bitboard(to));
 				break;
 			}
 			case PromotionPiece::ROOK:
 			{
-				rooks[static_cast<int>(color)].addPiece(Utility::calculateSquareNumber(to));
-				setPieceBitboard(PieceType::ROOK, color, getPieceBitboard(PieceType::ROOK, color) | Bitboard(to));
+				landingPiece = PieceType::ROOK;
+				togglePiece(PieceType::ROOK, color, Bitboard(to));
 				break;
 			}
 			case PromotionPiece::BISHOP:
 			{
-				bishops[static_cast<int>(color)].addPiece(Utility::calculateSquareNumber(to));
-				setPieceBitboard(PieceType::BISHOP, color, getPieceBitboard(PieceType::BISHOP, color) | Bitboard(to));
+				landingPiece = PieceType::BISHOP;
+				togglePiece(PieceType::BISHOP, color, Bitboard(to));
 				break;
 			}
 			case PromotionPiece::KNIGHT:
 			{
-				knights[static_cast<int>(color)].addPiece(Utility::calculateSquareNumber(to));
-				setPieceBitboard(PieceType::KNIGHT, color, getPieceBitboard(PieceType::KNIGHT, color) | Bitboard(to));
+				landingPiece = PieceType::KNIGHT;
+				togglePiece(PieceType::KNIGHT, color, Bitboard(to));
 				break;
 			}
 			default:
@@ -345,33 +326,11 @@ void Board::movePiece(Move move)
 	}
 	else
 	{
-		setPieceBitboard(piece, color, getPieceBitboard(piece, color) | Bitboard(to));
-		updatePieceList(piece, color, Utility::calculateSquareNumber(from), Utility::calculateSquareNumber(to), false);
+		togglePiece(piece, color, Bitboard(to));
 	}
 
-	// Update the captured piece bitboard and remove the piece from the piece lists
-	std::optional<PieceType> capturedPiece = move.getCapturedPiece();
-	if (capturedPiece.has_value())
-	{
-		Color capturedPieceColor = color == Color::WHITE ? Color::BLACK : Color::WHITE;
-		Bitboard capturedPieceBitboard = getPieceBitboard(capturedPiece.value(), capturedPieceColor);
-
-		if (specialMove == SpecialMove::EN_PASSANT)
-		{
-			Position enPassantTargetSquare = move.getEnPassantTargetSquare().value();
-			Position capturedPiecePosition = Position{enPassantTargetSquare.row + (color == Color::WHITE ? 1 : -1), enPassantTargetSquare.col};
-			setPieceBitboard(capturedPiece.value(), capturedPieceColor, capturedPieceBitboard & ~Bitboard(capturedPiecePosition));
-			updatePieceList(capturedPiece.value(), capturedPieceColor, Utility::calculateSquareNumber(from), Utility::calculateSquareNumber(capturedPiecePosition), true);
-
-			// Clear the en passant target square
-			setEnPassantTargetSquare(std::nullopt);
-		}
-		else
-		{
-			setPieceBitboard(capturedPiece.value(), capturedPieceColor, capturedPieceBitboard & ~Bitboard(to));
-			updatePieceList(capturedPiece.value(), capturedPieceColor, Utility::calculateSquareNumber(from), Utility::calculateSquareNumber(to), true);
-		}
-	}
+	// The mailbox is updated after the capture so that the moving piece overwrites the captured one
+	setSquare(Utility::calculateSquareNumber(to), landingPiece, color);
 
 	// Update the en passant target square on double pawn pushes
 	if (specialMove == SpecialMove::DOUBLE_PAWN_PUSH)
@@ -387,54 +346,48 @@ void Board::movePiece(Move move)
 		Position rookFrom = Position{from.row, (specialMove == SpecialMove::KINGSIDE_CASTLE ? 7 : 0)};
 		Position rookTo = Position{from.row, (specialMove == SpecialMove::KINGSIDE_CASTLE ? 5 : 3)};
 
-		// Clear the rook bitboard from the from square and set it on the to square
-		setPieceBitboard(PieceType::ROOK, color, getPieceBitboard(PieceType::ROOK, color) & ~Bitboard(rookFrom));
-		setPieceBitboard(PieceType::ROOK, color, getPieceBitboard(PieceType::ROOK, color) | Bitboard(rookTo));
+		// Move the rook bitboard from the from square to the to square
+		togglePiece(PieceType::ROOK, color, Bitboard(rookFrom) | Bitboard(rookTo));
 
-		// Update the rook piece list
-		updatePieceList(PieceType::ROOK, color, Utility::calculateSquareNumber(rookFrom), Utility::calculateSquareNumber(rookTo), false);
+		// Update the mailbox
+		clearSquare(Utility::calculateSquareNumber(rookFrom));
+		setSquare(Utility::calculateSquareNumber(rookTo), PieceType::ROOK, color);
 	}
+
+	return capturedPiece;
 }
 
-void Board::unmovePiece(Move move)
+void Board::unmovePiece(Move move, Color color, std::optional<PieceType> capturedPiece)
 {
 	Position from = move.getFrom();
-	PieceType piece = move.getPieceType();
-	Color color = move.getColor();
 	Position to = move.getTo();
 	SpecialMove specialMove = move.getSpecialMove();
+	PieceType piece = (specialMove == SpecialMove::PROMOTION) ? PieceType::PAWN : getPiece(to, color).value();
 
-	// Clear the piece bitboard from the to square and update the piece list
+	// Clear the piece bitboard from the to square
 	if (specialMove == SpecialMove::PROMOTION)
 	{
-		// Add the pawn back to the piece list
-		pawns[static_cast<int>(color)].addPiece(Utility::calculateSquareNumber(from));
-
-		// Remove the promoted piece from the piece list and clear the piece bitboard
+		// The promoted piece is removed, the pawn goes back on the from square below
 		switch (move.getPromotionPiece())
 		{
 			case PromotionPiece::QUEEN:
 			{
-				queens[static_cast<int>(color)].removePiece(Utility::calculateSquareNumber(to));
-				setPieceBitboard(PieceType::QUEEN, color, getPieceBitboard(PieceType::QUEEN, color) & ~Bitboard(to));
+				togglePiece(PieceType::QUEEN, color, Bitboard(to));
 				break;
 			}
 			case PromotionPiece::ROOK:
 			{
-				rooks[static_cast<int>(color)].removePiece(Utility::calculateSquareNumber(to));
-				setPieceBitboard(PieceType::ROOK, color, getPieceBitboard(PieceType::ROOK, color) & ~Bitboard(to));
+				togglePiece(PieceType::ROOK, color, Bitboard(to));
 				break;
 			}
 			case PromotionPiece::BISHOP:
 			{
-				bishops[static_cast<int>(color)].removePiece(Utility::calculateSquareNumber(to));
-				setPieceBitboard(PieceType::BISHOP, color, getPieceBitboard(PieceType::BISHOP, color) & ~Bitboard(to));
+				togglePiece(PieceType::BISHOP, color, Bitboard(to));
 				break;
 			}
 			case PromotionPiece::KNIGHT:
 			{
-				knights[static_cast<int>(color)].removePiece(Utility::calculateSquareNumber(to));
-				setPieceBitboard(PieceType::KNIGHT, color, getPieceBitboard(PieceType::KNIGHT, color) & ~Bitboard(to));
+				togglePiece(PieceType::KNIGHT, color, Bitboard(to));
 				break;
 			}
 			default:
@@ -443,20 +396,18 @@ void Board::unmovePiece(Move move)
 	}
 	else
 	{
-		// Clear the piece bitboard from the to square and update the piece list
-		setPieceBitboard(piece, color, getPieceBitboard(piece, color) & ~Bitboard(to));
-		updatePieceList(piece, color, Utility::calculateSquareNumber(to), Utility::calculateSquareNumber(from), false);
+		togglePiece(piece, color, Bitboard(to));
 	}
 
 	// Set the piece bitboard back on the from square
-	setPieceBitboard(piece, color, getPieceBitboard(piece, color) | Bitboard(from));
+	togglePiece(piece, color, Bitboard(from));
+	clearSquare(Utility::calculateSquareNumber(to));
+	setSquare(Utility::calculateSquareNumber(from), piece, color);
 
-	// If a piece was captured, set the captured piece bitboard and update the piece list
-	std::optional<PieceType> capturedPiece = move.getCapturedPiece();
+	// If a piece was captured, put it back
 	if (capturedPiece.has_value())
 	{
 		Color capturedPieceColor = color == Color::WHITE ? Color::BLACK : Color::WHITE;
-		Bitboard capturedPieceBitboard = getPieceBitboard(capturedPiece.value(), capturedPieceColor);
 		Position capturedPiecePosition = to;
 
 		if (specialMove == SpecialMove::EN_PASSANT)
@@ -464,108 +415,96 @@ void Board::unmovePiece(Move move)
 			capturedPiecePosition = Position{to.row + (color == Color::WHITE ? 1 : -1), to.col};
 		}
 
-		setPieceBitboard(capturedPiece.value(), capturedPieceColor, capturedPieceBitboard | Bitboard(capturedPiecePosition));
-		PieceList capturedPieceList = getPieceList(capturedPiece.value(), capturedPieceColor);
-		capturedPieceList.addPiece(Utility::calculateSquareNumber(capturedPiecePosition));
-		setPieceList(capturedPiece.value(), capturedPieceColor, capturedPieceList);
+		togglePiece(capturedPiece.value(), capturedPieceColor, Bitboard(capturedPiecePosition));
+		setSquare(Utility::calculateSquareNumber(capturedPiecePosition), capturedPiece.value(), capturedPieceColor);
 	}
 
-	// Set the en passant target square back
-	setEnPassantTargetSquare(move.getEnPassantTargetSquare());
-
 	if (specialMove == SpecialMove::KINGSIDE_CASTLE || specialMove == SpecialMove::QUEENSIDE_CASTLE)
 	{
 		// Move the appropriate rook
 		Position rookFrom = Position{from.row, (specialMove == SpecialMove::KINGSIDE_CASTLE ? 5 : 3)};
 		Position rookTo = Position{from.row, (specialMove == SpecialMove::KINGSIDE_CASTLE ? 7 : 0)};
 
-		// Clear the rook bitboard from the to square and set it on the to square
-		setPieceBitboard(PieceType::ROOK, color, getPieceBitboard(PieceType::ROOK, color) & ~Bitboard(rookFrom));
-		setPieceBitboard(PieceType::ROOK, color, getPieceBitboard(PieceType::ROOK, color) | Bitboard(rookTo));
-
-		// Update the rook piece list
-		updatePieceList(PieceType::ROOK, color, Utility::calculateSquareNumber(rookFrom), Utility::calculateSquareNumber(rookTo), false);
-	}
-}
+		// Move the rook bitboard from the from square to the to square
+		togglePiece(PieceType::ROOK, color, Bitboard(rookFrom) | Bitboard(rookTo));
 
-void Board::initializePieceLists()
-{
-	for (int color = 0; color < 2; color++)
-	{
-		pawns[color] = PieceList(8);
-		knights[color] = PieceList(10);
-		bishops[color] = PieceList(10);
-		rooks[color] = PieceList(10);
-		queens[color] = PieceList(9);
+		// Update the mailbox
+		clearSquare(Utility::calculateSquareNumber(rookFrom));
+		setSquare(Utility::calculateSquareNumber(rookTo), PieceType::ROOK, color);
 	}
 }
 
-void Board::initializeAttacks()
+void Board::validateFenPosition(const std::string &fenPosition) const
 {
-	pawnAttacks = PrecomputedData::pawnAttacks;
-	knightAttacks = PrecomputedData::knightAttacks;
-	kingAttacks = PrecomputedData::kingAttacks;
-}
+	// Checked before anything is placed, a bad position would otherwise write outside the board
+	const std::string pieceCharacters = "pnbrqkPNBRQK";
+	std::array<int, 12> pieceCounts{};
+	int rowIndex = 0;
+	int colIndex = 0;
 
-// ? Might be worth in the future to remove duplicate ray calculations, ex a1-h1 and h1-a1
-void Board::initializeRays()
-{
-	for (int from = 0; from < 64; from++)
+	for (char c : fenPosition)
 	{
-		for (int to = 0; to < 64; to++)
+		if (c == '/')
 		{
-			if (isValidRay(from, to))
-			{
-				rays[from][to] = calculateRay(from, to);
-			}
-			else
+			if (colIndex != 8)
 			{
-				rays[from][to] = Bitboard(0);
+				throw std::invalid_argument("Invalid FEN - each rank must describe exactly 8 squares");
 			}
+			rowIndex++;
+			colIndex = 0;
+		}
+		else if (c >= '1' && c <= '8')
+		{
+			colIndex += c - '0';
+		}
+		else if (pieceCharacters.find(c) != std::string::npos)
+		{
+			pieceCounts[pieceCharacters.find(c)]++;
+			colIndex++;
+		}
+		else
+		{
+			throw std::invalid_argument(std::string("Invalid FEN - unknown piece character '") + c + "'");
 		}
-	}
-}
 
-bool Board::isValidRay(int from, int to)
-{
-	Position fromPosition = Utility::calculatePosition(from);
-	Position toPosition = Utility::calculatePosition(to);
+		if (colIndex > 8 || rowIndex > 7)
+		{
+			throw std::invalid_argument("Invalid FEN - each rank must describe exactly 8 squares");
+		}
+	}
 
-	if (fromPosition.row == toPosition.row || fromPosition.col == toPosition.col)
+	if (rowIndex != 7 || colIndex != 8)
 	{
-		return true;
+		throw std::invalid_argument("Invalid FEN - the position must describe exactly 8 ranks of 8 squares");
 	}
 
-	int rowDiff = abs(fromPosition.row - toPosition.row);
-	int colDiff = abs(fromPosition.col - toPosition.col);
-
-	return rowDiff == colDiff;
-}
-
-Bitboard Board::calculateRay(int from, int to)
-{
-    Position fromPosition = Utility::calculatePosition(from);
-    Position toPosition = Utility::calculatePosition(to);
-
-    int rowDiff = toPosition.row - fromPosition.row;
-    int colDiff = toPosition.col - fromPosition.col;
-
-    int rowDirection = rowDiff > 0 ? 1 : (rowDiff < 0 ? -1 : 0);
-    int colDirection = colDiff > 0 ? 1 : (colDiff < 0 ? -1 : 0);
+	// Every piece beyond a side's original set is a promoted pawn, so pawns and extra pieces together are at most eight
+	constexpr std::array<int, 5> originalCounts = {8, 2, 2, 2, 1};
+	for (int side = 0; side < 2; side++)
+	{
+		const int *counts = &pieceCounts[side * 6];
+		if (counts[5] != 1)
+		{
+			throw std::invalid_argument("Invalid FEN - each side must have exactly one king");
+		}
 
-    Bitboard ray = Bitboard(0);
-    Position current = {fromPosition.row + rowDirection, fromPosition.col + colDirection};
-    while (current.row != toPosition.row || current.col != toPosition.col)
-    {
-        ray |= Bitboard(current);
-        current = {current.row + rowDirection, current.col + colDirection};
-    }
+		int promotedPieces = 0;
+		for (int piece = 1; piece < 5; piece++)
+		{
+			promotedPieces += std::max(0, counts[piece] - originalCounts[piece]);
+		}
 
-    return ray;
+		if (counts[0] + promotedPieces > 8)
+		{
+			throw std::invalid_argument("Invalid FEN - too many pieces for one side");
+		}
+	}
 }
 
 void Board::parseFenPosition(std::string fenPosition)
 {
+	validateFenPosition(fenPosition);
+
 	int rowIndex = 0;
 	int colIndex = 0;
 
@@ -596,48 +535,27 @@ void Board::parseFenPosition(std::string fenPosition)
 
 			Position position{rowIndex, colIndex};
 			int square = Utility::calculateSquareNumber(position);
-			setPieceBitboard(piece, color, getPieceBitboard(piece, color) | Bitboard(position));
-			loadPieceFromFen(piece, color, square);
+			togglePiece(piece, color, Bitboard(position));
+			setSquare(square, piece, color);
 			colIndex++;
 		}
 	}
 }
 
-void Board::loadPieceFromFen(PieceType piece, Color color, int square)
-{
-	switch (piece)
-		{
-			case PieceType::PAWN:
-				pawns[static_cast<int>(color)].addPiece(square);
-				break;
-			case PieceType::KNIGHT:
-				knights[static_cast<int>(color)].addPiece(square);
-				break;
-			case PieceType::BISHOP:
-				bishops[static_cast<int>(color)].addPiece(square);
-				break;
-			case PieceType::ROOK:
-				rooks[static_cast<int>(color)].addPiece(square);
-				break;
-			case PieceType::QUEEN:
-				queens[static_cast<int>(color)].addPiece(square);
-				break;
-			case PieceType::KING:
-				kings[static_cast<int>(color)] = square;
-				break;
-		}
-}
-
 void Board::parseFenEnPassantTargetSquare(std::string fenEnPassantTargetSquare)
 {
 	if (fenEnPassantTargetSquare == "-")
 	{
 		enPassantTargetSquare = std::nullopt;
 	}
-	else
+	else if (fenEnPassantTargetSquare.size() == 2 && fenEnPassantTargetSquare[0] >= 'a' && fenEnPassantTargetSquare[0] <= 'h' && (fenEnPassantTargetSquare[1] == '3' || fenEnPassantTargetSquare[1] == '6'))
 	{
 		enPassantTargetSquare = Utility::convertStringToPosition(fenEnPassantTargetSquare);
 	}
+	else
+	{
+		throw std::invalid_argument("Invalid FEN - the en passant target square must be '-' or a square on the third or sixth rank");
+	}
 }
 
 char Board::pieceToChar(PieceType piece, Color color) const
@@ -661,29 +579,26 @@ char Board::pieceToChar(PieceType piece, Color color) const
 	}
 }
 
-void Board::updatePieceList(PieceType piece, Color color, int from, int to, bool isRemoved)
+void Board::togglePiece(PieceType piece, Color color, Bitboard squares)
 {
-	if (piece == PieceType::KING) // The king is not in the piece lists and therefore cannot be updated
-	{
-		// King cannot be removed so we only need to update the king's position
-		if (!isRemoved)
-			{
-				setKing(color, to);
-			}
+	pieceBitboards[static_cast<int>(color)][static_cast<int>(piece)] ^= squares;
+	colorBitboards[static_cast<int>(color)] ^= squares;
+	occupiedBitboard ^= squares;
 
-		return;
-	}
-
-	PieceList pieceList = getPieceList(piece, color);
-
-	if (isRemoved)
-	{
-		pieceList.removePiece(to);
-	}
-	else
+	while (squares.getValue())
 	{
-		pieceList.movePiece(from, to);
+		int square = squares.bitScanForward();
+		squares.clearBit(square);
+		zobristKey ^= Zobrist::getPieceKey(piece, color, square);
 	}
+}
 
-	setPieceList(piece, color, pieceList);
+void Board::setSquare(int square, PieceType piece, Color color)
+{
+	mailbox[square] = static_cast<uint8_t>(piece) | (static_cast<uint8_t>(color) << 3);
+}
+
+void Board::clearSquare(int square)
+{
+	mailbox[square] = EMPTY_SQUARE;
 }
\ No newline at end of file
@@ -1,2 +1,16 @@
-// #include "Evalulation.hpp"
+#include "../include/Evalulation.hpp"
 
+int Evalulation::evaluate(Board &board, Color color)
+{
+	Color opponentColor = (color == Color::WHITE) ? Color::BLACK : Color::WHITE;
+
+	// Material only, the king is on the board for both sides and cancels out
+	int score = 0;
+	for (PieceType piece : {PieceType::PAWN, PieceType::KNIGHT, PieceType::BISHOP, PieceType::ROOK, PieceType::QUEEN})
+	{
+		int count = __builtin_popcountll(board.getPieceBitboard(piece, color).getValue()) - __builtin_popcountll(board.getPieceBitboard(piece, opponentColor).getValue());
+		score += count * getPieceValue(piece);
+	}
+
+	return score;
+}
\ No newline at end of file
@@ -1,8 +1,13 @@
 #include "../include/Game.hpp"
 #include "../include/MoveValidator.hpp"
+#include "../include/MoveGenerator.hpp"
 #include "../include/Utility.hpp"
 
 #include <sstream>
+#include <cassert>
+#include <atomic>
+#include <chrono>
+#include <thread>
 
 Game::Game(std::string fen) : Game(getFenTokens(fen))
 {
@@ -10,10 +15,15 @@ Game::Game(std::string fen) : Game(getFenTokens(fen))
 
 Game::Game(std::vector<std::string> fenParts) : board(fenParts[0], fenParts[3])
 {
-	parseActiveColor(fenParts[1]);
-	parseCastlingRights(fenParts[2]);
-	parsehalfMoveClock(fenParts[4]);
-	parseFullMoveNumber(fenParts[5]);
+	parseGameState(fenParts);
+}
+
+void Game::setFen(std::string fen)
+{
+	std::vector<std::string> fenParts = getFenTokens(fen);
+	board.setPosition(fenParts[0], fenParts[3]);
+	moveHistory.clear(); // Keeps its capacity, so a reused game does not allocate again
+	parseGameState(fenParts);
 }
 
 Color Game::getActiveColor() const
@@ -23,6 +33,11 @@ Color Game::getActiveColor() const
 
 void Game::setActiveColor(Color activeColor)
 {
+	if (this->activeColor != activeColor)
+	{
+		zobristKey ^= Zobrist::getSideToMoveKey();
+	}
+
 	this->activeColor = activeColor;
 }
 
@@ -98,6 +113,11 @@ CastleRights Game::getBlackCastleRights() const
 }
 
 Move Game::getLastMove() const
+{
+	return getLastUndoInfo().move;
+}
+
+UndoInfo Game::getLastUndoInfo() const
 {
 	if (moveHistory.size() == 0)
 	{
@@ -107,6 +127,16 @@ Move Game::getLastMove() const
 	return moveHistory.back();
 }
 
+uint64_t Game::getZobristKey() const
+{
+	return board.getZobristKey() ^ zobristKey;
+}
+
+uint64_t Game::computeZobristKey() const
+{
+	return board.computeZobristKey() ^ computeStateZobristKey();
+}
+
 void Game::makeMove(Position from, Position to, PromotionPiece promotionPiece)
 {
 	if (!board.getPiece(from, activeColor).has_value())
@@ -121,25 +151,45 @@ void Game::makeMove(Position from, Position to, PromotionPiece promotionPiece)
 	// Get move details
 	std::optional<PieceType> capturedPiece = getCapturedPiece(piece, from, to);
 	SpecialMove specialMove = getSpecialMove(piece, from, to, capturedPiece, promotionPiece);
-	std::optional<Position> enPassantTargetSquare = board.getEnPassantTargetSquare();
-	Move move = Move(from, to, piece, activeColor, capturedPiece, enPassantTargetSquare, specialMove, promotionPiece, whiteCastleRights, blackCastleRights, halfMoveClock, fullMoveNumber);
-	addMoveToHistory(move);
+	Move move = Move(from, to, specialMove, promotionPiece, capturedPiece.has_value());
 
-	// Move piece
-	board.movePiece(move);
+	// The validator only checks how the piece moves, whether the move exposes the king is checked once it has been made
+	Color movingColor = activeColor;
+	doMove(move);
 
-	// Check if king is in check
-	if (isInCheck())
+	if (MoveValidator::isSquareAttacked(board, movingColor, board.getKing(movingColor)))
 	{
-		unmakeMove();
+		undoMove();
 		throw std::invalid_argument("Move puts king in check");
 	}
+}
+
+void Game::unmakeMove()
+{
+	if (moveHistory.size() == 0)
+	{
+		throw std::invalid_argument("No moves to undo");
+	}
+
+	undoMove();
+}
+
+void Game::doMove(Move move)
+{
+	Position from = move.getFrom();
+	Position to = move.getTo();
+	PieceType piece = board.getPiece(move.getFromSquare(), activeColor).value();
+
+	// Keep what the move destroys so that it can be taken back
+	UndoInfo undoInfo{move, std::nullopt, board.getEnPassantTargetSquare(), whiteCastleRights, blackCastleRights, halfMoveClock};
+	undoInfo.capturedPiece = board.movePiece(move, activeColor);
+	addMoveToHistory(undoInfo);
 
 	// Update castling rights
-	updateCastlingRights(piece, activeColor, from);
+	updateCastlingRights(piece, activeColor, from, to);
 
 	// Reset half move clock if a pawn is moved or a piece is captured
-	if (capturedPiece.has_value() || piece == PieceType::PAWN)
+	if (undoInfo.capturedPiece.has_value() || piece == PieceType::PAWN)
 	{
 		halfMoveClock = 0;
 	}
@@ -154,35 +204,38 @@ void Game::makeMove(Position from, Position to, PromotionPiece promotionPiece)
 		fullMoveNumber++;
 	}
 
-	hasCachedInCheckValue = false;
 	switchActiveColor();
+
+	// Debug builds check the incremental key against a full recompute after every move
+	assert(getZobristKey() == computeZobristKey());
 }
 
-void Game::unmakeMove()
+void Game::undoMove()
 {
-	if (moveHistory.size() == 0)
-	{
-		throw std::invalid_argument("No moves to undo");
-	}
-
 	// Get move details from history and remove move from history
-	Move move = moveHistory.back();
+	UndoInfo undoInfo = moveHistory.back();
 	moveHistory.pop_back();
 
+	// Switch active color to the color that made the move
+	switchActiveColor();
+
 	// Undo board move details
-	board.unmovePiece(move);
+	board.unmovePiece(undoInfo.move, activeColor, undoInfo.capturedPiece);
+	board.setEnPassantTargetSquare(undoInfo.enPassantTargetSquare);
 
 	// Undo castling rights
-	blackCastleRights = move.getBlackCastleRights();
-	whiteCastleRights = move.getWhiteCastleRights();
+	zobristKey ^= Zobrist::getCastlingKey(whiteCastleRights, blackCastleRights) ^ Zobrist::getCastlingKey(undoInfo.whiteCastleRights, undoInfo.blackCastleRights);
+	blackCastleRights = undoInfo.blackCastleRights;
+	whiteCastleRights = undoInfo.whiteCastleRights;
 
-	// Undo half move clock and full move number
-	halfMoveClock = move.getHalfMoveClock();
-	fullMoveNumber = move.getFullMoveNumber();
+	// Undo half move clock and full move number, the full move number only advanced if black made the move
+	halfMoveClock = undoInfo.halfMoveClock;
+	if (activeColor == Color::BLACK)
+	{
+		fullMoveNumber--;
+	}
 
-	// Switch active color to the color that made the move
-	activeColor = move.getColor();
-	hasCachedInCheckValue = false;
+	assert(getZobristKey() == computeZobristKey());
 }
 
 uint64_t Game::perft(int depth)
@@ -193,92 +246,194 @@ uint64_t Game::perft(int depth)
 	}
 
 	uint64_t nodes = 0;
-	std::vector<Move> moves = generateLegalMoves();
+	MoveList moves;
+	generateLegalMoves(moves);
+
+	// Every generated move is legal, so the last ply is counted without playing it
+	if (depth == 1)
+	{
+		return moves.size();
+	}
 
-	for (Move move : moves)
+	for (const Move &move : moves)
 	{
-		makeMove(move.getFrom(), move.getTo(), move.getPromotionPiece());
+		doMove(move);
 		nodes += perft(depth - 1);
-		unmakeMove();
+		undoMove();
+	}
+
+	return nodes;
+}
+
+uint64_t Game::perft(int depth, PerftCache &cache, PerftCacheStats &stats)
+{
+	if (depth == 0)
+	{
+		return 1;
+	}
+
+	// Subtrees one ply deep are cheaper to count than to look up
+	uint64_t key = getZobristKey();
+	uint64_t nodes = 0;
+	if (depth >= 2)
+	{
+		stats.probes++;
+		if (cache.probe(key, depth, nodes))
+		{
+			stats.hits++;
+			return nodes;
+		}
+	}
+
+	MoveList moves;
+	generateLegalMoves(moves);
+
+	if (depth == 1)
+	{
+		return moves.size();
+	}
+
+	for (const Move &move : moves)
+	{
+		doMove(move);
+		nodes += perft(depth - 1, cache, stats);
+		undoMove();
+	}
+
+	if (depth >= 2)
+	{
+		cache.store(key, depth, nodes);
 	}
 
 	return nodes;
 }
 
-void Game::perftRoot(int depth, std::map<std::string, int> &output)
+void Game::perftRoot(int depth, std::map<std::string, uint64_t> &output)
 {
     uint64_t totalNodes = 0;
-    std::vector<Move> moves = generateLegalMoves();
+    MoveList moves;
+    generateLegalMoves(moves);
 
-    for (Move move : moves)
+    for (const Move &move : moves)
     {
-        makeMove(move.getFrom(), move.getTo(), move.getPromotionPiece());
+        doMove(move);
         uint64_t nodes = perft(depth - 1);
-        unmakeMove();
-
-		std::string moveString = Utility::convertPositionToString(move.getFrom()) + Utility::convertPositionToString(move.getTo());
+        undoMove();
 
-		output[moveString] = nodes;
+		output[moveToString(move)] = nodes;
         totalNodes += nodes;
     }
 
 	output["Nodes"] = totalNodes;
 }
 
-std::vector<Move> Game::generateLegalMoves()
+PerftResult Game::perftParallel(int depth, int threadCount, PerftCache *cache)
 {
-	std::vector<Move> moves;
+	// A unit of work is one or two moves from the root followed by a sequential perft of what is left
+	struct PerftTask
+	{
+		Move rootMove;
+		std::optional<Move> childMove;
+		uint64_t nodes = 0;
+	};
 
-	for (int square = 0; square < 64; square++)
+	if (threadCount < 1)
 	{
-		// Get piece at square for active color
-		Position from = Utility::calculatePosition(square);
-		std::optional<PieceType> piece = board.getPiece(from, activeColor);
-		if (!piece.has_value())
+		throw std::invalid_argument("Invalid perft - at least one thread is needed");
+	}
+
+	PerftResult result;
+	auto start = std::chrono::steady_clock::now();
+
+	if (depth == 0)
+	{
+		result.nodes = 1;
+		return result;
+	}
+
+	MoveList rootMoves;
+	generateLegalMoves(rootMoves);
+
+	// With few root moves the threads would run out of work early, so split one ply deeper
+	std::vector<PerftTask> tasks;
+	bool splitDeeper = depth >= 3 && rootMoves.size() < threadCount * 4;
+	for (const Move &rootMove : rootMoves)
+	{
+		result.rootMoveNodes[moveToString(rootMove)] = 0;
+		if (!splitDeeper)
 		{
+			tasks.push_back(PerftTask{rootMove, std::nullopt});
 			continue;
 		}
 
-		// Loop through potential moves
-		Bitboard potentialMoves = MoveValidator::generatePotentialMoves(from, piece.value(), activeColor, board);
-		while (potentialMoves.getValue())
+		doMove(rootMove);
+		MoveList childMoves;
+		generateLegalMoves(childMoves);
+		for (const Move &childMove : childMoves)
 		{
-			// Get to square and remove from potential moves
-			int toSquare = potentialMoves.bitScanForward();
-			Position to = Utility::calculatePosition(toSquare);
-			potentialMoves.clearBit(toSquare);
+			tasks.push_back(PerftTask{rootMove, childMove});
+		}
+		undoMove();
+	}
 
-			// If move is invalid, continue
-			if (!isValidMove(from, to, piece.value()))
-			{
-				continue;
-			}
+	// Idle workers take the next unclaimed task, so a thread that finishes early keeps pulling work from the rest
+	std::atomic<size_t> nextTask{0};
+	result.threads.resize(threadCount);
+	std::vector<PerftCacheStats> cacheStats(threadCount);
+	std::vector<std::thread> workers;
+	for (int thread = 0; thread < threadCount; thread++)
+	{
+		workers.emplace_back([this, &tasks, &nextTask, &result, &cacheStats, cache, thread, depth, splitDeeper]() {
+			auto workerStart = std::chrono::steady_clock::now();
+			Game game = *this;
+			int remainingDepth = depth - (splitDeeper ? 2 : 1);
 
-			// If move puts friendly king in check, continue
-			// ! might need to be adjusted to account for promotion pieces
-			if (movePutsKingInCheck(from, to, piece.value()))
+			for (size_t task = nextTask++; task < tasks.size(); task = nextTask++)
 			{
-				continue;
-			}
+				game.doMove(tasks[task].rootMove);
+				if (tasks[task].childMove.has_value())
+				{
+					game.doMove(tasks[task].childMove.value());
+				}
 
-			// Get move details
-			if (piece.value() == PieceType::PAWN && (to.row == 0 || to.row == 7))
-			{
-				for (PromotionPiece promotionPiece : {PromotionPiece::QUEEN, PromotionPiece::ROOK, PromotionPiece::BISHOP, PromotionPiece::KNIGHT})
+				tasks[task].nodes = cache != nullptr ? game.perft(remainingDepth, *cache, cacheStats[thread]) : game.perft(remainingDepth);
+				result.threads[thread].nodes += tasks[task].nodes;
+
+				if (tasks[task].childMove.has_value())
 				{
-					Move move = composeMove(from, to, piece.value(), promotionPiece, whiteCastleRights, blackCastleRights, halfMoveClock, fullMoveNumber);
-					moves.push_back(move);
+					game.undoMove();
 				}
+				game.undoMove();
 			}
-			else
-			{
-				Move move = composeMove(from, to, piece.value(), PromotionPiece::NONE, whiteCastleRights, blackCastleRights, halfMoveClock, fullMoveNumber);
-				moves.push_back(move);
-			}
-		}
+
+			result.threads[thread].seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - workerStart).count();
+		});
+	}
+
+	for (std::thread &worker : workers)
+	{
+		worker.join();
+	}
+
+	for (const PerftTask &task : tasks)
+	{
+		result.rootMoveNodes[moveToString(task.rootMove)] += task.nodes;
+		result.nodes += task.nodes;
 	}
 
-	return moves;
+	for (const PerftCacheStats &stats : cacheStats)
+	{
+		result.cacheProbes += stats.probes;
+		result.cacheHits += stats.hits;
+	}
+
+	result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	return result;
+}
+
+void Game::generateLegalMoves(MoveList &moves)
+{
+	MoveGenerator::generateLegalMoves(*this, moves);
 }
 
 std::vector<std::string> Game::getFenTokens(std::string fen)
@@ -291,9 +446,24 @@ std::vector<std::string> Game::getFenTokens(std::string fen)
 		parts.push_back(part);
 	}
 
+	// Every later field is read by index, so a short FEN is rejected here for both the constructor and setFen
+	if (parts.size() != 6)
+	{
+		throw std::invalid_argument("Invalid FEN - expected 6 fields");
+	}
+
 	return parts;
 }
 
+void Game::parseGameState(std::vector<std::string> &fenParts)
+{
+	parseActiveColor(fenParts[1]);
+	parseCastlingRights(fenParts[2]);
+	parsehalfMoveClock(fenParts[4]);
+	parseFullMoveNumber(fenParts[5]);
+	zobristKey = computeStateZobristKey();
+}
+
 void Game::parseActiveColor(std::string color)
 {
 	if (color == "w")
@@ -329,7 +499,39 @@ void Game::parseCastlingRights(std::string castlingRights)
 
 void Game::switchActiveColor()
 {
-	activeColor == Color::WHITE ? activeColor = Color::BLACK : activeColor = Color::WHITE;
+	activeColor = (activeColor == Color::WHITE) ? Color::BLACK : Color::WHITE;
+	zobristKey ^= Zobrist::getSideToMoveKey();
+}
+
+std::string Game::moveToString(Move move) const
+{
+	std::string moveString = Utility::convertPositionToString(move.getFrom()) + Utility::convertPositionToString(move.getTo());
+
+	// Promotions are told apart by the piece, the same way long algebraic notation does
+	switch (move.getPromotionPiece())
+	{
+		case PromotionPiece::QUEEN:
+			return moveString + "q";
+		case PromotionPiece::ROOK:
+			return moveString + "r";
+		case PromotionPiece::BISHOP:
+			return moveString + "b";
+		case PromotionPiece::KNIGHT:
+			return moveString + "n";
+		default:
+			return moveString;
+	}
+}
+
+uint64_t Game::computeStateZobristKey() const
+{
+	uint64_t key = Zobrist::getCastlingKey(whiteCastleRights, blackCastleRights);
+	if (activeColor == Color::BLACK)
+	{
+		key ^= Zobrist::getSideToMoveKey();
+	}
+
+	return key;
 }
 
 void Game::incrementHalfMoveClock()
@@ -342,22 +544,24 @@ void Game::incrementFullMoveNumber()
 	fullMoveNumber++;
 }
 
-void Game::addMoveToHistory(Move move)
+void Game::addMoveToHistory(UndoInfo undoInfo)
 {
-	moveHistory.push_back(move);
+	moveHistory.push_back(undoInfo);
 }
 
 std::optional<PieceType> Game::getCapturedPiece(PieceType piece, Position from, Position to)
 {
 	Color opponentColor = (activeColor == Color::WHITE) ? Color::BLACK : Color::WHITE;
 
+	std::optional<PieceType> capturedPiece = board.getPiece(to, opponentColor);
+
 	// Regular capture
-	if (board.getPiece(to, opponentColor).has_value())
+	if (capturedPiece.has_value())
 	{
-		return board.getPiece(to, opponentColor);
+		return capturedPiece;
 	}
 	// En passant capture
-	else if (piece == PieceType::PAWN && abs(from.row - to.row) == 1 && abs(from.col - to.col) == 1 && !board.getPiece(to, opponentColor).has_value())
+	else if (piece == PieceType::PAWN && abs(from.row - to.row) == 1 && abs(from.col - to.col) == 1)
 	{
 		return PieceType::PAWN;
 	}
@@ -416,8 +620,10 @@ SpecialMove Game::getSpecialMove(PieceType piece, Position from, Position to, st
 	return SpecialMove::NONE;
 }
 
-void Game::updateCastlingRights(PieceType piece, Color color, Position from)
+void Game::updateCastlingRights(PieceType piece, Color color, Position from, Position to)
 {
+	uint64_t previousCastlingKey = Zobrist::getCastlingKey(whiteCastleRights, blackCastleRights);
+
 	// Update castling rights if king moves from starting position
 	if (piece == PieceType::KING && (from == Position{0, 4} || from == Position{7, 4}))
 	{
@@ -457,53 +663,24 @@ void Game::updateCastlingRights(PieceType piece, Color color, Position from)
 			}
 		}
 	}
-}
 
-bool Game::isInCheck()
-{
-	if (hasCachedInCheckValue)
+	// Capturing a rook on its starting square removes the opponent's castling right on that side
+	if (to == Position{0, 0})
 	{
-		return cachedInCheckValue;
+		blackCastleRights.disableQueenSide();
 	}
-
-	cachedInCheckValue = MoveValidator::isSquareAttacked(getBoard(), getActiveColor(), getBoard().getKing(getActiveColor()));
-	hasCachedInCheckValue = true;
-
-	return cachedInCheckValue;
-}
-
-bool Game::isValidMove(Position from, Position to, PieceType piece)
-{
-	try
+	else if (to == Position{0, 7})
 	{
-		MoveValidator::validateMove(from, to, piece, activeColor, *this);
-		return true;
+		blackCastleRights.disableKingSide();
 	}
-	catch(const std::exception& e)
+	else if (to == Position{7, 0})
 	{
-		return false;
+		whiteCastleRights.disableQueenSide();
 	}
-}
-
-bool Game::movePutsKingInCheck(Position from, Position to, PieceType piece)
-{
-	try
-	{
-		makeMove(from, to, PromotionPiece::NONE);
-		unmakeMove();
-		return false;
-	}
-	catch(const std::exception& e)
+	else if (to == Position{7, 7})
 	{
-		return true;
+		whiteCastleRights.disableKingSide();
 	}
-}
-
-Move Game::composeMove(Position from, Position to, PieceType piece, PromotionPiece promotionPiece, CastleRights whiteCastleRights, CastleRights blackCastleRights, int halfMoveClock, int fullMoveNumber)
-{
-	std::optional<PieceType> capturedPiece = getCapturedPiece(piece, from, to);
-	SpecialMove specialMove = getSpecialMove(piece, from, to, capturedPiece, PromotionPiece::NONE);
-	std::optional<Position> enPassantTargetSquare = board.getEnPassantTargetSquare();
 
-	return Move(from, to, piece, activeColor, capturedPiece, enPassantTargetSquare, specialMove, promotionPiece, whiteCastleRights, blackCastleRights, halfMoveClock, fullMoveNumber);
+	zobristKey ^= previousCastlingKey ^ Zobrist::getCastlingKey(whiteCastleRights, blackCastleRights);
 }
\ No newline at end of file
@@ -1,38 +1,15 @@
 #include "../include/MagicBitboards.hpp"
-#include "../include/structs/Position.hpp"
-#include "../include/Utility.hpp"
-#include "../include/PrecomputedData.hpp"
 
-std::once_flag MagicBitboards::initFlag;
-
-std::array<uint64_t, 64> MagicBitboards::rookMagics = {};
-std::array<uint64_t, 64> MagicBitboards::bishopMagics = {};
-std::array<int, 64> MagicBitboards::rookShifts = {};
-std::array<int, 64> MagicBitboards::bishopShifts = {};
-std::array<uint64_t, 64> MagicBitboards::rookMasks = {};
-std::array<uint64_t, 64> MagicBitboards::bishopMasks = {};
-std::array<std::array<uint64_t, 4096>, 64> MagicBitboards::rookAttacks = {};
-std::array<std::array<uint64_t, 512>, 64> MagicBitboards::bishopAttacks = {};
-
-void MagicBitboards::init()
+Bitboard MagicBitboards::getSliderAttacks(int square, Bitboard occupied, PieceType pieceType)
 {
-	std::call_once(initFlag, []() {
-		rookMagics = PrecomputedData::rookMagics;
-		bishopMagics = PrecomputedData::bishopMagics;
-		rookShifts = PrecomputedData::rookShifts;
-		bishopShifts = PrecomputedData::bishopShifts;
-		rookMasks = PrecomputedData::rookMasks;
-		bishopMasks = PrecomputedData::bishopMasks;
-
-		for (int square = 0; square < 64; ++square)
-		{
-			rookAttacks[square] = createTable<4096>(square, true, rookMagics[square], rookShifts[square]);
-			bishopAttacks[square] = createTable<512>(square, false, bishopMagics[square], bishopShifts[square]);
-		}
-	});
+#ifdef USE_PEXT
+	return getPextSliderAttacks(square, occupied, pieceType);
+#else
+	return getMagicSliderAttacks(square, occupied, pieceType);
+#endif
 }
 
-Bitboard MagicBitboards::getSliderAttacks(int square, Bitboard occupied, PieceType pieceType)
+Bitboard MagicBitboards::getMagicSliderAttacks(int square, Bitboard occupied, PieceType pieceType)
 {
 	switch (pieceType)
 	{
@@ -49,74 +26,41 @@ Bitboard MagicBitboards::getSliderAttacks(int square, Bitboard occupied, PieceTy
 
 Bitboard MagicBitboards::getRookAttacks(int square, Bitboard occupied)
 {
-	uint64_t index = (rookMasks[square] & occupied.getValue()) * rookMagics[square] >> rookShifts[square];
-	return rookAttacks[square][index];
+	const SliderMagic &entry = PrecomputedData::rookSliderMagics[square];
+	return entry.attacks[entry.getIndex(occupied.getValue())];
 }
 
 Bitboard MagicBitboards::getBishopAttacks(int square, Bitboard occupied)
 {
-	uint64_t index = (bishopMasks[square] & occupied.getValue()) * bishopMagics[square] >> bishopShifts[square];
-	return bishopAttacks[square][index];
+	const SliderMagic &entry = PrecomputedData::bishopSliderMagics[square];
+	return entry.attacks[entry.getIndex(occupied.getValue())];
 }
 
-std::vector<uint64_t> MagicBitboards::createAllBlockerPatterns(uint64_t mask)
+#ifdef USE_PEXT
+Bitboard MagicBitboards::getPextSliderAttacks(int square, Bitboard occupied, PieceType pieceType)
 {
-	// Create a vector containing indices of the set bits in the mask
-	std::vector<int> maskBits = {};
-	for (int square = 0; square < 64; square++)
-	{
-		if (((mask >> square) & 1) == 1)
-		{
-			maskBits.push_back(square);
-		}
-	}
-
-	int numPatterns = 1 << maskBits.size();
-	std::vector<uint64_t> blockerBitboards;
-	blockerBitboards.resize(numPatterns, 0);
-
-	for (int patternIndex = 0; patternIndex < numPatterns; patternIndex++)
+	switch (pieceType)
 	{
-		for (int bitIndex = 0; bitIndex < maskBits.size(); bitIndex++)
-		{
-			int bit = (patternIndex >> bitIndex) & 1;
-			blockerBitboards[patternIndex] |= (static_cast<u_int64_t>(bit) << maskBits[bitIndex]);
-		}
+	case PieceType::ROOK:
+		return getPextRookAttacks(square, occupied);
+	case PieceType::BISHOP:
+		return getPextBishopAttacks(square, occupied);
+	case PieceType::QUEEN:
+		return getPextBishopAttacks(square, occupied) | getPextRookAttacks(square, occupied);
+	default:
+		return Bitboard(0);
 	}
-
-	return blockerBitboards;
 }
 
-uint64_t MagicBitboards::legalMovesFromBlockers(int square, uint64_t blockers, bool rook)
+Bitboard MagicBitboards::getPextRookAttacks(int square, Bitboard occupied)
 {
-	Bitboard moves;
-	std::array<Position, 4> directions = rook ?
-		std::array<Position, 4>{{{1, 0}, {-1, 0}, {0, 1}, {0, -1}}} :
-		std::array<Position, 4>{{{1, 1}, {-1, -1}, {1, -1}, {-1, 1}}};
-	Position startPos = Utility::calculatePosition(square);
-
-	for (Position direction : directions)
-	{
-		for (int distance = 1; distance < 8; distance++)
-		{
-			Position targetPos = Position{startPos.row + (direction.row * distance), startPos.col + (direction.col * distance)};
-			try
-			{
-				Utility::validatePosition(targetPos);
-			}
-			catch(const std::exception& e)
-			{
-				break;
-			}
-
-			// If target is valid, set the bit in the moves bitboard, and check if there is a blocker at the target position
-			moves.setBit(targetPos);
-			if (Bitboard(blockers).getBit(targetPos))
-			{
-				break;
-			}
-		}
-	}
+	uint64_t mask = PrecomputedData::rookSliderMagics[square].mask;
+	return PrecomputedData::rookPextAttacks[PrecomputedData::rookPextOffsets[square] + _pext_u64(occupied.getValue(), mask)];
+}
 
-	return moves.getValue();
+Bitboard MagicBitboards::getPextBishopAttacks(int square, Bitboard occupied)
+{
+	uint64_t mask = PrecomputedData::bishopSliderMagics[square].mask;
+	return PrecomputedData::bishopPextAttacks[PrecomputedData::bishopPextOffsets[square] + _pext_u64(occupied.getValue(), mask)];
 }
+#endif
\ No newline at end of file
@@ -1,227 +1,174 @@
 #include "../include/Move.hpp"
 #include "../include/Utility.hpp"
 
-Move::Move(Position from, Position to, PieceType pieceType, Color color,
-		   std::optional<PieceType> capturedPiece, std::optional<Position> enPassantTargetSquare,
-		   SpecialMove specialMove, PromotionPiece promotionPiece, CastleRights whiteCastleRights,
-		   CastleRights blackCastleRights, uint8_t halfMoveClock, uint16_t fullMoveNumber)
+Move::Move(Position from, Position to, SpecialMove specialMove, PromotionPiece promotionPiece, bool isCapture) : move(0)
 {
 	setFrom(from);
 	setTo(to);
-	setPieceType(pieceType);
-	setColor(color);
-	setCapturedPiece(capturedPiece);
-	setEnPassantTargetSquare(enPassantTargetSquare);
-	setSpecialMove(specialMove);
-	setPromotionPiece(promotionPiece);
-	setWhiteCastleRights(whiteCastleRights);
-	setBlackCastleRights(blackCastleRights);
-	setHalfMoveClock(halfMoveClock);
-	setFullMoveNumber(fullMoveNumber);
+	move = encode(FLAGS_MASK, FLAGS_SHIFT, createFlags(specialMove, promotionPiece, isCapture));
 }
 
-Position Move::getFrom() const
+Move::Move(int from, int to, SpecialMove specialMove, PromotionPiece promotionPiece, bool isCapture)
 {
-	int fromSquare = decode(FROM_MASK, FROM_SHIFT);
-	int row = fromSquare / 8;
-	int col = fromSquare % 8;
+	// Used by move generation, the squares are trusted to be on the board
+	move = (from << FROM_SHIFT) | (to << TO_SHIFT) | (createFlags(specialMove, promotionPiece, isCapture) << FLAGS_SHIFT);
+}
 
-	return Position{row, col};
+Position Move::getFrom() const
+{
+	return Utility::calculatePosition(getFromSquare());
 }
 
 void Move::setFrom(Position from)
 {
 	Utility::validatePosition(from);
 
-	int fromSquare = from.row * 8 + from.col;
-
-	move = encode(FROM_MASK, FROM_SHIFT, fromSquare);
+	move = encode(FROM_MASK, FROM_SHIFT, Utility::calculateSquareNumber(from));
 }
 
 Position Move::getTo() const
 {
-	int toSquare = decode(TO_MASK, TO_SHIFT);
-	int row = toSquare / 8;
-	int col = toSquare % 8;
-
-	return Position{row, col};
+	return Utility::calculatePosition(getToSquare());
 }
 
 void Move::setTo(Position to)
 {
 	Utility::validatePosition(to);
 
-	int toSquare = to.row * 8 + to.col;
-
-	move = encode(TO_MASK, TO_SHIFT, toSquare);
+	move = encode(TO_MASK, TO_SHIFT, Utility::calculateSquareNumber(to));
 }
 
-PieceType Move::getPieceType() const
+int Move::getFromSquare() const
 {
-	int pieceType = decode(PIECE_TYPE_MASK, PIECE_TYPE_SHIFT);
-
-	return static_cast<PieceType>(pieceType);
+	return decode(FROM_MASK, FROM_SHIFT);
 }
 
-void Move::setPieceType(PieceType pieceType)
+int Move::getToSquare() const
 {
-	move = encode(PIECE_TYPE_MASK, PIECE_TYPE_SHIFT, static_cast<int>(pieceType));
+	return decode(TO_MASK, TO_SHIFT);
 }
 
-Color Move::getColor() const
-{
-	int color = decode(COLOR_MASK, COLOR_SHIFT);
-
-	return static_cast<Color>(color);
-}
-
-void Move::setColor(Color color)
+SpecialMove Move::getSpecialMove() const
 {
-	move = encode(COLOR_MASK, COLOR_SHIFT, static_cast<int>(color));
-}
+	uint16_t flags = decode(FLAGS_MASK, FLAGS_SHIFT);
 
-std::optional<PieceType> Move::getCapturedPiece() const
-{
-	if (decode(CAPTURED_PIECE_PRESENT_MASK, CAPTURED_PIECE_PRESENT_SHIFT))
+	if (flags & PROMOTION_FLAG)
 	{
-		int capturedPiece = decode(CAPTURED_PIECE_MASK, CAPTURED_PIECE_SHIFT);
-
-		return static_cast<PieceType>(capturedPiece);
+		return SpecialMove::PROMOTION;
 	}
 
-	return std::nullopt;
-}
-
-void Move::setCapturedPiece(std::optional<PieceType> capturedPiece)
-{
-	if (capturedPiece.has_value())
+	switch (flags)
 	{
-		move = encode(CAPTURED_PIECE_PRESENT_MASK, CAPTURED_PIECE_PRESENT_SHIFT, 1);
-		move = encode(CAPTURED_PIECE_MASK, CAPTURED_PIECE_SHIFT, static_cast<int>(capturedPiece.value()));
-	}
-	else
-	{
-		move = encode(CAPTURED_PIECE_PRESENT_MASK, CAPTURED_PIECE_PRESENT_SHIFT, 0);
+		case DOUBLE_PAWN_PUSH_FLAG:
+			return SpecialMove::DOUBLE_PAWN_PUSH;
+		case KINGSIDE_CASTLE_FLAG:
+			return SpecialMove::KINGSIDE_CASTLE;
+		case QUEENSIDE_CASTLE_FLAG:
+			return SpecialMove::QUEENSIDE_CASTLE;
+		case EN_PASSANT_FLAG:
+			return SpecialMove::EN_PASSANT;
+		default:
+			return SpecialMove::NONE;
 	}
 }
 
-std::optional<Position> Move::getEnPassantTargetSquare() const
+PromotionPiece Move::getPromotionPiece() const
 {
-	if (decode(EN_PASSANT_TARGET_SQUARE_PRESENT_MASK, EN_PASSANT_TARGET_SQUARE_PRESENT_SHIFT))
-	{
-		int enPassantTargetSquare = decode(EN_PASSANT_TARGET_SQUARE_MASK, EN_PASSANT_TARGET_SQUARE_SHIFT);
-		int row = enPassantTargetSquare / 8;
-		int col = enPassantTargetSquare % 8;
-
-		return Position{row, col};
-	}
+	uint16_t flags = decode(FLAGS_MASK, FLAGS_SHIFT);
 
-	return std::nullopt;
-}
-
-void Move::setEnPassantTargetSquare(std::optional<Position> enPassantTargetSquare)
-{
-	if (enPassantTargetSquare.has_value())
+	if (!(flags & PROMOTION_FLAG))
 	{
-		int row = enPassantTargetSquare.value().row;
-		int col = enPassantTargetSquare.value().col;
-
-		Utility::validatePosition(enPassantTargetSquare.value());
-
-		int enPassantTargetSquare = row * 8 + col;
-
-		move = encode(EN_PASSANT_TARGET_SQUARE_PRESENT_MASK, EN_PASSANT_TARGET_SQUARE_PRESENT_SHIFT, 1);
-		move = encode(EN_PASSANT_TARGET_SQUARE_MASK, EN_PASSANT_TARGET_SQUARE_SHIFT, enPassantTargetSquare);
+		return PromotionPiece::NONE;
 	}
-	else
+
+	// The low two bits hold the promotion piece, knight first
+	switch (flags & 0x3)
 	{
-		move = encode(EN_PASSANT_TARGET_SQUARE_PRESENT_MASK, EN_PASSANT_TARGET_SQUARE_PRESENT_SHIFT, 0);
+		case 0:
+			return PromotionPiece::KNIGHT;
+		case 1:
+			return PromotionPiece::BISHOP;
+		case 2:
+			return PromotionPiece::ROOK;
+		default:
+			return PromotionPiece::QUEEN;
 	}
 }
 
-SpecialMove Move::getSpecialMove() const
+bool Move::isCapture() const
 {
-	int specialMove = decode(SPECIAL_MOVE_MASK, SPECIAL_MOVE_SHIFT);
-
-	return static_cast<SpecialMove>(specialMove);
+	return decode(FLAGS_MASK, FLAGS_SHIFT) & CAPTURE_FLAG;
 }
 
-void Move::setSpecialMove(SpecialMove specialMove)
+uint16_t Move::getValue() const
 {
-	move = encode(SPECIAL_MOVE_MASK, SPECIAL_MOVE_SHIFT, static_cast<int>(specialMove));
+	return move;
 }
 
-PromotionPiece Move::getPromotionPiece() const
-{
-	int promotionPiece = decode(PROMOTION_PIECE_MASK, PROMOTION_PIECE_SHIFT);
-
-	return static_cast<PromotionPiece>(promotionPiece);
-}
-
-void Move::setPromotionPiece(PromotionPiece promotionPiece)
-{
-	move = encode(PROMOTION_PIECE_MASK, PROMOTION_PIECE_SHIFT, static_cast<int>(promotionPiece));
-}
-
-CastleRights Move::getWhiteCastleRights() const
-{
-	bool whiteCastleKingside = decode(WHITE_CASTLE_KINGSIDE_MASK, WHITE_CASTLE_KINGSIDE_SHIFT);
-	bool whiteCastleQueenside = decode(WHITE_CASTLE_QUEENSIDE_MASK, WHITE_CASTLE_QUEENSIDE_SHIFT);
-
-	return CastleRights{whiteCastleKingside, whiteCastleQueenside};
-}
-
-void Move::setWhiteCastleRights(CastleRights whiteCastleRights)
-{
-	move = encode(WHITE_CASTLE_KINGSIDE_MASK, WHITE_CASTLE_KINGSIDE_SHIFT, whiteCastleRights.canCastleKingSide());
-	move = encode(WHITE_CASTLE_QUEENSIDE_MASK, WHITE_CASTLE_QUEENSIDE_SHIFT, whiteCastleRights.canCastleQueenSide());
-}
-
-CastleRights Move::getBlackCastleRights() const
-{
-	bool blackCastleKingside = decode(BLACK_CASTLE_KINGSIDE_MASK, BLACK_CASTLE_KINGSIDE_SHIFT);
-	bool blackCastleQueenside = decode(BLACK_CASTLE_QUEENSIDE_MASK, BLACK_CASTLE_QUEENSIDE_SHIFT);
-
-	return CastleRights{blackCastleKingside, blackCastleQueenside};
-}
-
-void Move::setBlackCastleRights(CastleRights blackCastleRights)
+bool Move::operator==(const Move &other) const
 {
-	move = encode(BLACK_CASTLE_KINGSIDE_MASK, BLACK_CASTLE_KINGSIDE_SHIFT, blackCastleRights.canCastleKingSide());
-	move = encode(BLACK_CASTLE_QUEENSIDE_MASK, BLACK_CASTLE_QUEENSIDE_SHIFT, blackCastleRights.canCastleQueenSide());
+	return move == other.move;
 }
 
-uint8_t Move::getHalfMoveClock() const
+bool Move::operator!=(const Move &other) const
 {
-	return decode(HALF_MOVE_CLOCK_MASK, HALF_MOVE_CLOCK_SHIFT);
+	return move != other.move;
 }
 
-void Move::setHalfMoveClock(uint8_t halfMoveClock)
+uint16_t Move::createFlags(SpecialMove specialMove, PromotionPiece promotionPiece, bool isCapture)
 {
-	move = encode(HALF_MOVE_CLOCK_MASK, HALF_MOVE_CLOCK_SHIFT, halfMoveClock);
-}
+	uint16_t flags = QUIET_FLAG;
 
-uint16_t Move::getFullMoveNumber() const
-{
-	return decode(FULL_MOVE_NUMBER_MASK, FULL_MOVE_NUMBER_SHIFT);
-}
+	switch (specialMove)
+	{
+		case SpecialMove::DOUBLE_PAWN_PUSH:
+			flags = DOUBLE_PAWN_PUSH_FLAG;
+			break;
+		case SpecialMove::KINGSIDE_CASTLE:
+			flags = KINGSIDE_CASTLE_FLAG;
+			break;
+		case SpecialMove::QUEENSIDE_CASTLE:
+			flags = QUEENSIDE_CASTLE_FLAG;
+			break;
+		case SpecialMove::EN_PASSANT:
+			return EN_PASSANT_FLAG;
+		case SpecialMove::PROMOTION:
+		{
+			switch (promotionPiece)
+			{
+				case PromotionPiece::KNIGHT:
+					flags = PROMOTION_FLAG | 0;
+					break;
+				case PromotionPiece::BISHOP:
+					flags = PROMOTION_FLAG | 1;
+					break;
+				case PromotionPiece::ROOK:
+					flags = PROMOTION_FLAG | 2;
+					break;
+				default:
+					flags = PROMOTION_FLAG | 3;
+					break;
+			}
+			break;
+		}
+		default:
+			break;
+	}
 
-void Move::setFullMoveNumber(uint16_t fullMoveNumber)
-{
-	move = encode(FULL_MOVE_NUMBER_MASK, FULL_MOVE_NUMBER_SHIFT, fullMoveNumber);
-}
+	if (isCapture)
+	{
+		flags |= CAPTURE_FLAG;
+	}
 
-bool Move::operator==(const Move &other) const
-{
-	return move == other.move;
+	return flags;
 }
 
-uint64_t Move::decode(uint64_t mask, uint8_t shift) const
+uint16_t Move::decode(uint16_t mask, uint8_t shift) const
 {
 	return (move & mask) >> shift;
 }
 
-uint64_t Move::encode(uint64_t mask, uint8_t shift, uint64_t value)
+uint16_t Move::encode(uint16_t mask, uint8_t shift, uint16_t value)
 {
 	return (move & ~mask) | ((value << shift) & mask);
 }
\ No newline at end of file
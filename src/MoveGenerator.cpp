@@ -0,0 +1,332 @@
+#include "../include/MoveGenerator.hpp"
+#include "../include/MoveValidator.hpp"
+#include "../include/PrecomputedData.hpp"
+#include "../include/Utility.hpp"
+
+#include <cassert>
+
+void MoveGenerator::generateLegalMoves(Game &game, MoveList &moves)
+{
+	generate<GenType::ALL>(game, moves);
+}
+
+template <GenType Type>
+void MoveGenerator::generate(Game &game, MoveList &moves)
+{
+	if (game.getActiveColor() == Color::WHITE)
+	{
+		generate<Color::WHITE, Type>(game, moves);
+	}
+	else
+	{
+		generate<Color::BLACK, Type>(game, moves);
+	}
+}
+
+template <Color Us, GenType Type>
+void MoveGenerator::generate(Game &game, MoveList &moves)
+{
+	if constexpr (Type == GenType::QUIET_CHECKS)
+	{
+		generateQuietChecks<Us>(game, moves);
+		return;
+	}
+
+	constexpr Color Them = (Us == Color::WHITE) ? Color::BLACK : Color::WHITE;
+	Board &board = game.getBoard();
+	Bitboard friendlyPieces = board.getColorBitboard(Us);
+	Bitboard opponentPieces = board.getColorBitboard(Them);
+	Bitboard occupied = friendlyPieces | opponentPieces;
+	LegalityContext context = MoveValidator::createLegalityContext(board, Us);
+	assert(Type != GenType::EVASIONS || context.isInCheck());
+
+	// Squares pieces other than pawns may move to for this class of moves
+	Bitboard targets = ~friendlyPieces;
+	if constexpr (Type == GenType::CAPTURES)
+	{
+		targets = opponentPieces;
+	}
+	else if constexpr (Type == GenType::QUIETS)
+	{
+		targets = ~occupied;
+	}
+
+	moves.clear();
+	generateKingMoves<Us>(board, targets, opponentPieces, context, moves);
+
+	// In double check only the king can move
+	if (context.isDoubleCheck())
+	{
+		return;
+	}
+
+	generatePawnMoves<Us, Type>(board, opponentPieces, occupied, context, moves);
+	generatePieceMoves<Us, PieceType::KNIGHT>(board, targets, opponentPieces, occupied, context, moves);
+	generatePieceMoves<Us, PieceType::BISHOP>(board, targets, opponentPieces, occupied, context, moves);
+	generatePieceMoves<Us, PieceType::ROOK>(board, targets, opponentPieces, occupied, context, moves);
+	generatePieceMoves<Us, PieceType::QUEEN>(board, targets, opponentPieces, occupied, context, moves);
+
+	if constexpr (Type == GenType::QUIETS || Type == GenType::ALL)
+	{
+		if (!context.isInCheck())
+		{
+			generateCastlingMoves<Us>(game, occupied, context.opponentAttacks, moves);
+		}
+	}
+}
+
+template <Color Us, GenType Type>
+void MoveGenerator::generatePawnMoves(Board &board, Bitboard opponentPieces, Bitboard occupied, const LegalityContext &context, MoveList &moves)
+{
+	// Offsets toward the opponent, straight and diagonally towards column 0 and column 7
+	constexpr int up = (Us == Color::WHITE) ? -8 : 8;
+	constexpr int upLeft = up - 1;
+	constexpr int upRight = up + 1;
+	constexpr uint64_t promotionRow = (Us == Color::WHITE) ? 0xffULL : 0xffULL << 56;
+	// Single pushes that land here started on the starting row and may push again
+	constexpr uint64_t doublePushRow = (Us == Color::WHITE) ? 0xffULL << 40 : 0xffULL << 16;
+	constexpr uint64_t notColumn0 = ~0x0101010101010101ULL;
+	constexpr uint64_t notColumn7 = ~0x8080808080808080ULL;
+	// Promotions count as captures, so captures and quiets never overlap
+	constexpr bool includeCaptures = Type != GenType::QUIETS;
+	constexpr bool includeQuiets = Type != GenType::CAPTURES;
+
+	// Every pawn of the side is moved at once, pins and checks are applied per move when the targets are serialized
+	uint64_t pawns = board.getPieceBitboard(PieceType::PAWN, Us).getValue();
+	uint64_t empty = ~occupied.getValue();
+	uint64_t enemies = opponentPieces.getValue();
+	uint64_t singlePushes = shiftBitboard<up>(pawns) & empty;
+
+	if constexpr (includeQuiets)
+	{
+		uint64_t doublePushes = shiftBitboard<up>(singlePushes & doublePushRow) & empty;
+		addPawnMoves<up>(singlePushes & ~promotionRow, SpecialMove::NONE, false, context, moves);
+		addPawnMoves<2 * up>(doublePushes, SpecialMove::DOUBLE_PAWN_PUSH, false, context, moves);
+	}
+
+	if constexpr (includeCaptures)
+	{
+		uint64_t leftCaptures = shiftBitboard<upLeft>(pawns & notColumn0) & enemies;
+		uint64_t rightCaptures = shiftBitboard<upRight>(pawns & notColumn7) & enemies;
+
+		addPromotions<up>(singlePushes & promotionRow, false, context, moves);
+		addPromotions<upLeft>(leftCaptures & promotionRow, true, context, moves);
+		addPromotions<upRight>(rightCaptures & promotionRow, true, context, moves);
+		addPawnMoves<upLeft>(leftCaptures & ~promotionRow, SpecialMove::NONE, true, context, moves);
+		addPawnMoves<upRight>(rightCaptures & ~promotionRow, SpecialMove::NONE, true, context, moves);
+
+		// En passant removes two pieces from the same rank and can resolve a check by a pawn that is not on the target square,
+		// so the masks do not describe it and it is tested by playing it on the board instead
+		std::optional<Position> enPassantTargetSquare = board.getEnPassantTargetSquare();
+		if (enPassantTargetSquare.has_value())
+		{
+			constexpr Color Them = (Us == Color::WHITE) ? Color::BLACK : Color::WHITE;
+			int enPassantSquare = Utility::calculateSquareNumber(enPassantTargetSquare.value());
+
+			// The pawns that attack the target square are on the squares an opponent pawn there would attack
+			uint64_t attackers = pawns & PrecomputedData::pawnAttacks[static_cast<int>(Them)][enPassantSquare].getValue();
+			while (attackers)
+			{
+				int from = __builtin_ctzll(attackers);
+				attackers &= attackers - 1;
+
+				Move move = Move(from, enPassantSquare, SpecialMove::EN_PASSANT, PromotionPiece::NONE, true);
+				if (!leavesKingInCheck(board, move, Us))
+				{
+					moves.addMove(move);
+				}
+			}
+		}
+	}
+}
+
+template <int Offset>
+uint64_t MoveGenerator::shiftBitboard(uint64_t bits)
+{
+	if constexpr (Offset > 0)
+	{
+		return bits << Offset;
+	}
+	else
+	{
+		return bits >> -Offset;
+	}
+}
+
+template <int Offset>
+void MoveGenerator::addPawnMoves(uint64_t targets, SpecialMove specialMove, bool isCapture, const LegalityContext &context, MoveList &moves)
+{
+	while (targets)
+	{
+		int to = __builtin_ctzll(targets);
+		targets &= targets - 1;
+
+		int from = to - Offset;
+		if (context.getAllowedTargets(from).getBit(to))
+		{
+			moves.addMove(Move(from, to, specialMove, PromotionPiece::NONE, isCapture));
+		}
+	}
+}
+
+template <int Offset>
+void MoveGenerator::addPromotions(uint64_t targets, bool isCapture, const LegalityContext &context, MoveList &moves)
+{
+	while (targets)
+	{
+		int to = __builtin_ctzll(targets);
+		targets &= targets - 1;
+
+		int from = to - Offset;
+		if (context.getAllowedTargets(from).getBit(to))
+		{
+			for (PromotionPiece promotionPiece : {PromotionPiece::QUEEN, PromotionPiece::ROOK, PromotionPiece::BISHOP, PromotionPiece::KNIGHT})
+			{
+				moves.addMove(Move(from, to, SpecialMove::PROMOTION, promotionPiece, isCapture));
+			}
+		}
+	}
+}
+
+template <Color Us, PieceType Piece>
+void MoveGenerator::generatePieceMoves(Board &board, Bitboard targets, Bitboard opponentPieces, Bitboard occupied, const LegalityContext &context, MoveList &moves)
+{
+	Bitboard pieces = board.getPieceBitboard(Piece, Us);
+
+	while (pieces.getValue())
+	{
+		int from = pieces.bitScanForward();
+		pieces.clearBit(from);
+
+		Bitboard attacks;
+		if constexpr (Piece == PieceType::KNIGHT)
+		{
+			attacks = PrecomputedData::knightAttacks[from];
+		}
+		else
+		{
+			attacks = MagicBitboards::getSliderAttacks(from, occupied, Piece);
+		}
+
+		addMoves(from, attacks & targets & context.getAllowedTargets(from), opponentPieces, moves);
+	}
+}
+
+template <Color Us>
+void MoveGenerator::generateKingMoves(Board &board, Bitboard targets, Bitboard opponentPieces, const LegalityContext &context, MoveList &moves)
+{
+	int from = board.getKing(Us);
+	addMoves(from, targets & PrecomputedData::kingAttacks[from] & ~context.opponentAttacks, opponentPieces, moves);
+}
+
+template <Color Us>
+void MoveGenerator::generateCastlingMoves(Game &game, Bitboard occupied, Bitboard opponentAttacks, MoveList &moves)
+{
+	constexpr int castlingRow = (Us == Color::WHITE) ? 7 : 0;
+	constexpr int kingSquare = castlingRow * 8 + 4;
+
+	Board &board = game.getBoard();
+	CastleRights castleRights = (Us == Color::WHITE) ? game.getWhiteCastleRights() : game.getBlackCastleRights();
+	Bitboard rooks = board.getPieceBitboard(PieceType::ROOK, Us);
+
+	if (!castleRights.canCastle() || board.getKing(Us) != kingSquare)
+	{
+		return;
+	}
+
+	// The squares between the king and the rook must be empty, and the squares the king crosses and lands on must not be attacked.
+	// Castling out of check is ruled out by the caller
+	constexpr uint64_t kingsidePath = 0x60ULL << (castlingRow * 8);
+	constexpr uint64_t queensideEmpty = 0x0eULL << (castlingRow * 8);
+	constexpr uint64_t queensideSafe = 0x0cULL << (castlingRow * 8);
+
+	if (castleRights.canCastleKingSide() && rooks.getBit(kingSquare + 3) && !(occupied.getValue() & kingsidePath) && !(opponentAttacks.getValue() & kingsidePath))
+	{
+		moves.addMove(Move(kingSquare, kingSquare + 2, SpecialMove::KINGSIDE_CASTLE));
+	}
+
+	if (castleRights.canCastleQueenSide() && rooks.getBit(kingSquare - 4) && !(occupied.getValue() & queensideEmpty) && !(opponentAttacks.getValue() & queensideSafe))
+	{
+		moves.addMove(Move(kingSquare, kingSquare - 2, SpecialMove::QUEENSIDE_CASTLE));
+	}
+}
+
+template <Color Us>
+void MoveGenerator::generateQuietChecks(Game &game, MoveList &moves)
+{
+	Board &board = game.getBoard();
+	generate<Us, GenType::QUIETS>(game, moves);
+	CheckContext context = MoveValidator::createCheckContext(board, Us);
+
+	// Keep the checking quiets in place, a direct check lands on a check square and a discovered check leaves the slider's line
+	int checks = 0;
+	for (Move move : moves)
+	{
+		int from = move.getFromSquare();
+		SpecialMove specialMove = move.getSpecialMove();
+		bool givesCheck = (specialMove == SpecialMove::KINGSIDE_CASTLE || specialMove == SpecialMove::QUEENSIDE_CASTLE)
+			? castlingGivesCheck(board, move, Us)
+			: context.givesCheck(board.getPiece(from, Us).value(), from, move.getToSquare());
+
+		if (givesCheck)
+		{
+			moves[checks] = move;
+			checks++;
+		}
+	}
+	moves.count = checks;
+}
+
+void MoveGenerator::addMoves(int from, Bitboard targets, Bitboard opponentPieces, MoveList &moves)
+{
+	while (targets.getValue())
+	{
+		int to = targets.bitScanForward();
+		targets.clearBit(to);
+
+		moves.addMove(Move(from, to, SpecialMove::NONE, PromotionPiece::NONE, opponentPieces.getBit(to)));
+	}
+}
+
+bool MoveGenerator::leavesKingInCheck(Board &board, Move move, Color friendlyColor)
+{
+	// Plays the move on the board only, without touching the game state or validating it again
+	std::optional<Position> enPassantTargetSquare = board.getEnPassantTargetSquare();
+	std::optional<PieceType> capturedPiece = board.movePiece(move, friendlyColor);
+	bool inCheck = MoveValidator::isSquareAttacked(board, friendlyColor, board.getKing(friendlyColor));
+	board.unmovePiece(move, friendlyColor, capturedPiece);
+	board.setEnPassantTargetSquare(enPassantTargetSquare);
+
+	return inCheck;
+}
+
+bool MoveGenerator::castlingGivesCheck(Board &board, Move move, Color friendlyColor)
+{
+	// Only the rook can give check, from the square next to where the king lands
+	int kingFrom = move.getFromSquare();
+	int kingTo = move.getToSquare();
+	bool kingside = move.getSpecialMove() == SpecialMove::KINGSIDE_CASTLE;
+	int rookFrom = kingside ? kingFrom + 3 : kingFrom - 4;
+	int rookTo = kingside ? kingFrom + 1 : kingFrom - 1;
+	Color opponentColor = (friendlyColor == Color::WHITE) ? Color::BLACK : Color::WHITE;
+
+	Bitboard occupied = board.getOccupiedBitboard() ^ Bitboard((1ULL << kingFrom) | (1ULL << kingTo) | (1ULL << rookFrom) | (1ULL << rookTo));
+	return MagicBitboards::getSliderAttacks(rookTo, occupied, PieceType::ROOK).getBit(board.getKing(opponentColor));
+}
+
+// Every generator the rest of the engine can ask for
+template void MoveGenerator::generate<GenType::CAPTURES>(Game &game, MoveList &moves);
+template void MoveGenerator::generate<GenType::QUIETS>(Game &game, MoveList &moves);
+template void MoveGenerator::generate<GenType::EVASIONS>(Game &game, MoveList &moves);
+template void MoveGenerator::generate<GenType::QUIET_CHECKS>(Game &game, MoveList &moves);
+template void MoveGenerator::generate<GenType::ALL>(Game &game, MoveList &moves);
+template void MoveGenerator::generate<Color::WHITE, GenType::CAPTURES>(Game &game, MoveList &moves);
+template void MoveGenerator::generate<Color::WHITE, GenType::QUIETS>(Game &game, MoveList &moves);
+template void MoveGenerator::generate<Color::WHITE, GenType::EVASIONS>(Game &game, MoveList &moves);
+template void MoveGenerator::generate<Color::WHITE, GenType::QUIET_CHECKS>(Game &game, MoveList &moves);
+template void MoveGenerator::generate<Color::WHITE, GenType::ALL>(Game &game, MoveList &moves);
+template void MoveGenerator::generate<Color::BLACK, GenType::CAPTURES>(Game &game, MoveList &moves);
+template void MoveGenerator::generate<Color::BLACK, GenType::QUIETS>(Game &game, MoveList &moves);
+template void MoveGenerator::generate<Color::BLACK, GenType::EVASIONS>(Game &game, MoveList &moves);
+template void MoveGenerator::generate<Color::BLACK, GenType::QUIET_CHECKS>(Game &game, MoveList &moves);
+template void MoveGenerator::generate<Color::BLACK, GenType::ALL>(Game &game, MoveList &moves);
\ No newline at end of file
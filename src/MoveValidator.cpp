@@ -1,4 +1,5 @@
 #include "../include/MoveValidator.hpp"
+#include "../include/PrecomputedData.hpp"
 #include "../include/Utility.hpp"
 
 #include <stdexcept>
@@ -56,75 +57,64 @@ void MoveValidator::validateMove(Position from, Position to, PieceType piece, Co
 
 bool MoveValidator::isSquareAttacked(Board &board, Color friendlyColor, int square)
 {
-	Bitboard occupied = board.getOccupiedBitboard();
+	return isSquareAttacked(board, friendlyColor, square, board.getOccupiedBitboard());
+}
+
+bool MoveValidator::isSquareAttacked(Board &board, Color friendlyColor, int square, Bitboard occupied)
+{
 	Color opponentColor = (friendlyColor == Color::WHITE) ? Color::BLACK : Color::WHITE;
+	return (board.attackersTo(square, occupied).getValue() & board.getColorBitboard(opponentColor).getValue()) != 0;
+}
 
-	if (board.getRooks(opponentColor).count > 0)
-	{
-		Bitboard enemyRooks = board.getPieceBitboard(PieceType::ROOK, opponentColor);
-		Bitboard rookAttacks = MagicBitboards::getSliderAttacks(square, occupied, PieceType::ROOK);
-		if (rookAttacks.getValue() & enemyRooks.getValue())
-		{
-			return true;
-		}
-	}
+Bitboard MoveValidator::getAttackedSquares(Board &board, Color attackingColor, Bitboard occupied)
+{
+	constexpr uint64_t notColumn0 = ~0x0101010101010101ULL;
+	constexpr uint64_t notColumn7 = ~0x8080808080808080ULL;
 
-	if (board.getBishops(opponentColor).count > 0)
-	{
-		Bitboard enemyBishops = board.getPieceBitboard(PieceType::BISHOP, opponentColor);
-		Bitboard bishopAttacks = MagicBitboards::getSliderAttacks(square, occupied, PieceType::BISHOP);
-		if (bishopAttacks.getValue() & enemyBishops.getValue())
-		{
-			return true;
-		}
-	}
+	// Pawns attack set-wise, white ones toward row 0 and black ones toward row 7
+	uint64_t pawns = board.getPieceBitboard(PieceType::PAWN, attackingColor).getValue();
+	Bitboard attacks = (attackingColor == Color::WHITE)
+		? Bitboard(((pawns & notColumn0) >> 9) | ((pawns & notColumn7) >> 7))
+		: Bitboard(((pawns & notColumn0) << 7) | ((pawns & notColumn7) << 9));
 
-	if (board.getQueens(opponentColor).count > 0)
+	Bitboard knights = board.getPieceBitboard(PieceType::KNIGHT, attackingColor);
+	while (knights.getValue())
 	{
-		Bitboard enemyQueens = board.getPieceBitboard(PieceType::QUEEN, opponentColor);
-		Bitboard queenAttacks = MagicBitboards::getSliderAttacks(square, occupied, PieceType::QUEEN);
-		if (queenAttacks.getValue() & enemyQueens.getValue())
-		{
-			return true;
-		}
+		int square = knights.bitScanForward();
+		knights.clearBit(square);
+		attacks |= PrecomputedData::knightAttacks[square];
 	}
 
-	if (board.getKnights(opponentColor).count > 0)
+	Bitboard queens = board.getPieceBitboard(PieceType::QUEEN, attackingColor);
+	Bitboard diagonalSliders = board.getPieceBitboard(PieceType::BISHOP, attackingColor) | queens;
+	while (diagonalSliders.getValue())
 	{
-		Bitboard enemyKnights = board.getPieceBitboard(PieceType::KNIGHT, opponentColor);
-		Bitboard knightAttacks = board.getAttacks(PieceType::KNIGHT, opponentColor, square);
-		if (knightAttacks.getValue() & enemyKnights.getValue())
-		{
-			return true;
-		}
+		int square = diagonalSliders.bitScanForward();
+		diagonalSliders.clearBit(square);
+		attacks |= MagicBitboards::getSliderAttacks(square, occupied, PieceType::BISHOP);
 	}
 
-	if (board.getPawns(opponentColor).count > 0)
+	Bitboard orthogonalSliders = board.getPieceBitboard(PieceType::ROOK, attackingColor) | queens;
+	while (orthogonalSliders.getValue())
 	{
-		Bitboard enemyPawns = board.getPieceBitboard(PieceType::PAWN, opponentColor);
-		Bitboard pawnAttacks = board.getAttacks(PieceType::PAWN, opponentColor, square);
-		if (pawnAttacks.getValue() & enemyPawns.getValue())
-		{
-			return true;
-		}
+		int square = orthogonalSliders.bitScanForward();
+		orthogonalSliders.clearBit(square);
+		attacks |= MagicBitboards::getSliderAttacks(square, occupied, PieceType::ROOK);
 	}
 
-	if (board.getKing(opponentColor))
-	{
-		Bitboard enemyKings = board.getPieceBitboard(PieceType::KING, opponentColor);
-		Bitboard kingAttacks = board.getAttacks(PieceType::KING, opponentColor, square);
-		if (kingAttacks.getValue() & enemyKings.getValue())
-		{
-			return true;
-		}
-	}
+	attacks |= PrecomputedData::kingAttacks[board.getKing(attackingColor)];
 
-	return false;
+	return attacks;
 }
 
 Bitboard MoveValidator::findAbsolutePins(Board &board, Color friendlyColor)
 {
-	Bitboard pinned;
+	return createLegalityContext(board, friendlyColor).pinned;
+}
+
+LegalityContext MoveValidator::createLegalityContext(Board &board, Color friendlyColor)
+{
+	LegalityContext context;
 	Bitboard occupied = board.getOccupiedBitboard();
 	Bitboard friendlyPieces = board.getColorBitboard(friendlyColor);
 	Color opponentColor = (friendlyColor == Color::WHITE) ? Color::BLACK : Color::WHITE;
@@ -132,23 +122,65 @@ Bitboard MoveValidator::findAbsolutePins(Board &board, Color friendlyColor)
 	Bitboard opponentBQ = board.getPieceBitboard(PieceType::BISHOP, opponentColor) | board.getPieceBitboard(PieceType::QUEEN, opponentColor);
 	int kingSquare = board.getKing(friendlyColor);
 
-	Bitboard pinner = xrayAttacks(occupied, friendlyPieces, kingSquare, PieceType::ROOK) & opponentRQ;
-	while (pinner.getValue())
+	// Every opponent piece that attacks the king square
+	context.checkers = board.attackersTo(kingSquare, occupied) & board.getColorBitboard(opponentColor);
+
+	// A single check can be answered by capturing the checker or blocking the ray between it and the king.
+	// A double check leaves only king moves, which are not filtered by the mask
+	if (context.isDoubleCheck())
 	{
-		int pinnerSquare = pinner.bitScanForward();
-		pinned |= getObstructedRay(board.getRay(pinnerSquare, kingSquare), occupied) & friendlyPieces;
-		pinner &= (pinner.getValue() - 1);
+		context.checkMask = Bitboard(0);
 	}
-
-	pinner = xrayAttacks(occupied, friendlyPieces, kingSquare, PieceType::BISHOP) & opponentBQ;
-	while (pinner.getValue())
+	else if (context.isInCheck())
 	{
-		int pinnerSquare = pinner.bitScanForward();
-		pinned |= getObstructedRay(board.getRay(pinnerSquare, kingSquare), occupied) & friendlyPieces;
-		pinner &= (pinner.getValue() - 1);
+		Bitboard checker = context.checkers;
+		context.checkMask = board.getRay(checker.bitScanForward(), kingSquare) | context.checkers;
 	}
 
-	return pinned;
+	addPins(board, xrayAttacks(occupied, friendlyPieces, kingSquare, PieceType::ROOK) & opponentRQ, occupied, friendlyPieces, kingSquare, context);
+	addPins(board, xrayAttacks(occupied, friendlyPieces, kingSquare, PieceType::BISHOP) & opponentBQ, occupied, friendlyPieces, kingSquare, context);
+
+	// The king is taken off the board so that sliders checking it also attack the squares behind it
+	context.opponentAttacks = getAttackedSquares(board, opponentColor, occupied & ~Bitboard(1ULL << kingSquare));
+
+	return context;
+}
+
+CheckContext MoveValidator::createCheckContext(Board &board, Color friendlyColor)
+{
+	CheckContext context;
+	Bitboard occupied = board.getOccupiedBitboard();
+	Bitboard friendlyPieces = board.getColorBitboard(friendlyColor);
+	Color opponentColor = (friendlyColor == Color::WHITE) ? Color::BLACK : Color::WHITE;
+	Bitboard friendlyRQ = board.getPieceBitboard(PieceType::ROOK, friendlyColor) | board.getPieceBitboard(PieceType::QUEEN, friendlyColor);
+	Bitboard friendlyBQ = board.getPieceBitboard(PieceType::BISHOP, friendlyColor) | board.getPieceBitboard(PieceType::QUEEN, friendlyColor);
+	int kingSquare = board.getKing(opponentColor);
+
+	// Pieces attack the king from the squares the same piece would attack from the king square, pawns from where an opponent pawn would attack
+	context.checkSquares[static_cast<int>(PieceType::PAWN)] = board.getAttacks(PieceType::PAWN, opponentColor, kingSquare);
+	context.checkSquares[static_cast<int>(PieceType::KNIGHT)] = board.getAttacks(PieceType::KNIGHT, opponentColor, kingSquare);
+	context.checkSquares[static_cast<int>(PieceType::BISHOP)] = MagicBitboards::getSliderAttacks(kingSquare, occupied, PieceType::BISHOP);
+	context.checkSquares[static_cast<int>(PieceType::ROOK)] = MagicBitboards::getSliderAttacks(kingSquare, occupied, PieceType::ROOK);
+	context.checkSquares[static_cast<int>(PieceType::QUEEN)] = context.checkSquares[static_cast<int>(PieceType::BISHOP)] | context.checkSquares[static_cast<int>(PieceType::ROOK)];
+
+	// Sliders lined up with the king on an empty board, any with a single friendly piece in between uncover a check when it leaves the line
+	Bitboard snipers = (MagicBitboards::getSliderAttacks(kingSquare, Bitboard(0), PieceType::ROOK) & friendlyRQ) | (MagicBitboards::getSliderAttacks(kingSquare, Bitboard(0), PieceType::BISHOP) & friendlyBQ);
+	while (snipers.getValue())
+	{
+		int sniperSquare = snipers.bitScanForward();
+		snipers.clearBit(sniperSquare);
+
+		Bitboard ray = board.getRay(sniperSquare, kingSquare);
+		Bitboard blockers = ray & occupied;
+		if (blockers.getValue() != 0 && (blockers.getValue() & (blockers.getValue() - 1)) == 0 && (blockers & friendlyPieces).getValue() != 0)
+		{
+			int blockerSquare = blockers.bitScanForward();
+			context.discoverers.setBit(blockerSquare);
+			context.discoveryRays[blockerSquare] = ray | Bitboard(1ULL << sniperSquare);
+		}
+	}
+
+	return context;
 }
 
 Bitboard MoveValidator::generatePotentialMoves(Position position, PieceType piece, Color friendlyColor, Board &board)
@@ -279,8 +311,11 @@ void MoveValidator::validateKingMove(Position from, Position to, PieceType piece
 	}
 	else
 	{
-		// Check if the king is moving into check
-		if (isSquareAttacked(game.getBoard(), friendlyColor, Utility::calculateSquareNumber(to)))
+		// Check if the king is moving into check, with the king off the board so it cannot step back along a checking slider's line
+		Board &board = game.getBoard();
+		Color opponentColor = (friendlyColor == Color::WHITE) ? Color::BLACK : Color::WHITE;
+		Bitboard occupiedWithoutKing = board.getOccupiedBitboard() & ~Bitboard(1ULL << board.getKing(friendlyColor));
+		if (getAttackedSquares(board, opponentColor, occupiedWithoutKing).getBit(to))
 		{
 			throw std::invalid_argument("Invalid move - The king cannot move into check");
 		}
@@ -305,6 +340,14 @@ void MoveValidator::validateCastlingMove(Position from, Position to, Color frien
 		}
 
 		Board &board = game.getBoard();
+		Color opponentColor = (friendlyColor == Color::WHITE) ? Color::BLACK : Color::WHITE;
+		Bitboard opponentAttacks = getAttackedSquares(board, opponentColor, board.getOccupiedBitboard());
+
+		// Check if the king is castling out of check
+		if (opponentAttacks.getBit(from))
+		{
+			throw std::invalid_argument("Invalid move - The king cannot castle out of check");
+		}
 
 		// Check if the squares between the king and the rook are empty
 		int direction = (to.col > from.col) ? 1 : -1;
@@ -315,8 +358,8 @@ void MoveValidator::validateCastlingMove(Position from, Position to, Color frien
 				throw std::invalid_argument("Invalid move - The path between the king and the rook is not clear");
 			}
 
-			// Check if the king is castling through check
-			if (isSquareAttacked(board, friendlyColor, Utility::calculateSquareNumber(Position{from.row, i})))
+			// Check if the king is castling through check - only the squares the king crosses matter, not the b-file
+			if (abs(i - from.col) <= 2 && opponentAttacks.getBit(Position{from.row, i}))
 			{
 				throw std::invalid_argument("Invalid move - The king cannot castle through check");
 			}
@@ -330,43 +373,11 @@ void MoveValidator::validateCastlingMove(Position from, Position to, Color frien
 
 bool MoveValidator::isValidPinnedPieceMove(Position from, Position to, Color friendlyColor, Board &board)
 {
-	Bitboard pinned = findAbsolutePins(board, friendlyColor);
+	LegalityContext context = createLegalityContext(board, friendlyColor);
+	int fromSquare = Utility::calculateSquareNumber(from);
 
-	// Check if the piece being moved is pinned
-	if (pinned.getBit(from) == 1)
-	{
-		int kingSquare = board.getKing(friendlyColor);
-		Position kingPosition = Utility::calculatePosition(kingSquare);
-		Position pinDirection{(from.row < kingPosition.row) ? -1 : (from.row > kingPosition.row) ? 1 : 0,
-							  (from.col < kingPosition.col) ? -1 : (from.col > kingPosition.col) ? 1 : 0};
-		int pinningPieceSquare = -1;
-		Position current = from;
-		Color opponentColor = (friendlyColor == Color::WHITE) ? Color::BLACK : Color::WHITE;
-
-		// Find the piece that is pinning the pinned piece
-		while (Utility::isValidPosition(current))
-		{
-			current.row += pinDirection.row;
-			current.col += pinDirection.col;
-
-			if (board.getColorBitboard(opponentColor).getBit(current) == 1)
-			{
-				pinningPieceSquare = Utility::calculateSquareNumber(current);
-				break;
-			}
-		}
-
-		// Check if the move is along the pinning ray or to the pinning piece
-		Bitboard ray = board.getRay(pinningPieceSquare, kingSquare);
-		if (ray.getBit(to) || to == Utility::calculatePosition(pinningPieceSquare))
-		{
-			return true;
-		}
-
-		return false;
-	}
-
-	return true;
+	// A pinned piece can only move along the ray between the pinning piece and the king, or capture the pinning piece
+	return !context.pinned.getBit(fromSquare) || context.pinRays[fromSquare].getBit(to);
 }
 
 Bitboard MoveValidator::xrayAttacks(Bitboard occupied, Bitboard friendlyPieces, int kingSquare, PieceType piece)
@@ -395,4 +406,18 @@ Bitboard MoveValidator::getObstructedRay(Bitboard ray, Bitboard occupied)
 	}
 
 	return obstructedRay;
+}
+
+void MoveValidator::addPins(Board &board, Bitboard pinners, Bitboard occupied, Bitboard friendlyPieces, int kingSquare, LegalityContext &context)
+{
+	while (pinners.getValue())
+	{
+		int pinnerSquare = pinners.bitScanForward();
+		Bitboard ray = board.getRay(pinnerSquare, kingSquare);
+		Bitboard pinnedPiece = getObstructedRay(ray, occupied) & friendlyPieces;
+
+		context.pinned |= pinnedPiece;
+		context.pinRays[pinnedPiece.bitScanForward()] = ray | Bitboard(1ULL << pinnerSquare);
+		pinners &= (pinners.getValue() - 1);
+	}
 }
\ No newline at end of file
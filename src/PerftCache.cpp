@@ -0,0 +1,52 @@
+#include "../include/PerftCache.hpp"
+
+PerftCache::PerftCache(size_t megabytes)
+{
+	// Round down to a power of two so the index is a mask of the key
+	size_t maxEntries = megabytes * 1024 * 1024 / sizeof(Entry);
+	entryCount = 1;
+	while (entryCount * 2 <= maxEntries)
+	{
+		entryCount *= 2;
+	}
+
+	entries = std::make_unique<Entry[]>(entryCount);
+}
+
+bool PerftCache::probe(uint64_t key, int depth, uint64_t &nodes) const
+{
+	const Entry &entry = entries[key & (entryCount - 1)];
+	uint64_t data = entry.data.load(std::memory_order_relaxed);
+	uint64_t validation = entry.validation.load(std::memory_order_relaxed);
+
+	if ((validation ^ data) != key || static_cast<int>(data & 0xff) != depth)
+	{
+		return false;
+	}
+
+	nodes = data >> 8;
+	return true;
+}
+
+void PerftCache::store(uint64_t key, int depth, uint64_t nodes)
+{
+	Entry &entry = entries[key & (entryCount - 1)];
+	uint64_t data = (nodes << 8) | static_cast<uint64_t>(depth);
+
+	entry.validation.store(key ^ data, std::memory_order_relaxed);
+	entry.data.store(data, std::memory_order_relaxed);
+}
+
+void PerftCache::clear()
+{
+	for (size_t index = 0; index < entryCount; index++)
+	{
+		entries[index].validation.store(0, std::memory_order_relaxed);
+		entries[index].data.store(0, std::memory_order_relaxed);
+	}
+}
+
+size_t PerftCache::getEntryCount() const
+{
+	return entryCount;
+}
\ No newline at end of file
@@ -1,41 +1,254 @@
 #include "../include/PrecomputedData.hpp"
 
+#include <cstddef>
+
+namespace
+{
+	// Everything below runs at compile time, so the tables land in read-only data and nothing is built at startup
+
+	// Squares reached sliding from a square in each direction on an empty board.
+	// Directions that increase the square number come first, so the nearest blocker is the lowest set bit for them and the highest for the rest
+	constexpr std::array<uint64_t, 4> createDirectionRays(int square, bool rook)
+	{
+		constexpr int rookDirections[4][2] = {{1, 0}, {0, 1}, {-1, 0}, {0, -1}};
+		constexpr int bishopDirections[4][2] = {{1, 1}, {1, -1}, {-1, -1}, {-1, 1}};
+
+		std::array<uint64_t, 4> directionRays = {};
+		for (int direction = 0; direction < 4; direction++)
+		{
+			int rowStep = rook ? rookDirections[direction][0] : bishopDirections[direction][0];
+			int colStep = rook ? rookDirections[direction][1] : bishopDirections[direction][1];
+			for (int row = square / 8 + rowStep, col = square % 8 + colStep; row >= 0 && row < 8 && col >= 0 && col < 8; row += rowStep, col += colStep)
+			{
+				directionRays[direction] |= 1ULL << (row * 8 + col);
+			}
+		}
+
+		return directionRays;
+	}
+
+	constexpr uint64_t getHighestBit(uint64_t bits)
+	{
+		bits |= bits >> 1;
+		bits |= bits >> 2;
+		bits |= bits >> 4;
+		bits |= bits >> 8;
+		bits |= bits >> 16;
+		bits |= bits >> 32;
+		return bits ^ (bits >> 1);
+	}
+
+	constexpr uint64_t getRayAttacks(uint64_t ray, uint64_t blockers, bool increasing)
+	{
+		uint64_t blocked = ray & blockers;
+		if (blocked == 0)
+		{
+			return ray;
+		}
+
+		// Keep the ray up to and including the nearest blocker, since it may be a capture
+		if (increasing)
+		{
+			uint64_t nearest = blocked & (~blocked + 1);
+			return ray & (nearest | (nearest - 1));
+		}
+		return ray & ~(getHighestBit(blocked) - 1);
+	}
+
+	// Attacks along each ray, remembered with the blockers they were worked out for
+	struct RayAttacks
+	{
+		uint64_t rays[4];
+		uint64_t blockers[4] = {~0ULL, ~0ULL, ~0ULL, ~0ULL};
+		uint64_t attacks[4] = {};
+
+		constexpr RayAttacks(int square, bool rook) : rays{}
+		{
+			std::array<uint64_t, 4> directionRays = createDirectionRays(square, rook);
+			for (int direction = 0; direction < 4; direction++)
+			{
+				rays[direction] = directionRays[direction];
+			}
+		}
+
+		// Consecutive blocker sets mostly differ on one ray, so only that ray is worked out again
+		constexpr uint64_t getAttacks(uint64_t occupied)
+		{
+			uint64_t result = 0;
+			for (int direction = 0; direction < 4; direction++)
+			{
+				uint64_t rayBlockers = occupied & rays[direction];
+				if (rayBlockers != blockers[direction])
+				{
+					blockers[direction] = rayBlockers;
+					attacks[direction] = getRayAttacks(rays[direction], rayBlockers, direction < 2);
+				}
+				result |= attacks[direction];
+			}
+			return result;
+		}
+	};
+
+	// The loops read plain locals and write through a raw pointer, std::array's accessors would count against the constexpr operation limit for every entry
+	template <std::size_t N>
+	constexpr std::array<uint64_t, N> createMagicTable(const std::array<uint64_t, 64> &masks, const std::array<uint64_t, 64> &magics, const std::array<int, 64> &shifts, bool rook)
+	{
+		std::array<uint64_t, N> table = {};
+		uint64_t *entries = table.data();
+		for (int square = 0; square < 64; square++)
+		{
+			RayAttacks rayAttacks(square, rook);
+			uint64_t mask = masks[square];
+			uint64_t magic = magics[square];
+			int shift = shifts[square];
+
+			// Visit every subset of the mask, (blockers - mask) & mask steps to the next one
+			uint64_t blockers = 0;
+			do
+			{
+				entries[(blockers * magic) >> shift] = rayAttacks.getAttacks(blockers);
+				blockers = (blockers - mask) & mask;
+			} while (blockers != 0);
+
+			entries += 1ULL << (64 - shift);
+		}
+
+		return table;
+	}
+
+	constexpr std::array<SliderMagic, 64> createSliderMagics(const uint64_t *table, const std::array<uint64_t, 64> &masks, const std::array<uint64_t, 64> &magics, const std::array<int, 64> &shifts)
+	{
+		std::array<SliderMagic, 64> entries = {};
+		for (int square = 0; square < 64; square++)
+		{
+			entries[square] = SliderMagic{table, masks[square], magics[square], static_cast<unsigned int>(shifts[square])};
+			table += 1ULL << (64 - shifts[square]);
+		}
+
+		return entries;
+	}
+
+#ifdef USE_PEXT
+	template <std::size_t N>
+	constexpr std::array<uint64_t, N> createPextTable(const std::array<uint64_t, 64> &masks, bool rook)
+	{
+		std::array<uint64_t, N> table = {};
+		uint64_t *entries = table.data();
+		for (int square = 0; square < 64; square++)
+		{
+			RayAttacks rayAttacks(square, rook);
+			uint64_t mask = masks[square];
+
+			// Subsets come out in increasing order, which is exactly the order of their PEXT indices
+			uint64_t blockers = 0;
+			do
+			{
+				*entries++ = rayAttacks.getAttacks(blockers);
+				blockers = (blockers - mask) & mask;
+			} while (blockers != 0);
+		}
+
+		return table;
+	}
+
+	constexpr std::array<uint32_t, 64> createPextOffsets(const std::array<uint64_t, 64> &masks)
+	{
+		std::array<uint32_t, 64> offsets = {};
+		uint32_t offset = 0;
+		for (int square = 0; square < 64; square++)
+		{
+			offsets[square] = offset;
+			int bits = 0;
+			for (uint64_t mask = masks[square]; mask != 0; mask &= mask - 1)
+			{
+				bits++;
+			}
+			offset += 1U << bits;
+		}
+
+		return offsets;
+	}
+#endif
+
+	constexpr std::array<std::array<Bitboard, 64>, 64> createRays()
+	{
+		std::array<std::array<Bitboard, 64>, 64> rays = {};
+		for (int from = 0; from < 64; from++)
+		{
+			for (int to = 0; to < 64; to++)
+			{
+				int rowDiff = to / 8 - from / 8;
+				int colDiff = to % 8 - from % 8;
+				if (from == to || (rowDiff != 0 && colDiff != 0 && rowDiff != colDiff && rowDiff != -colDiff))
+				{
+					continue;
+				}
+
+				int rowStep = rowDiff > 0 ? 1 : (rowDiff < 0 ? -1 : 0);
+				int colStep = colDiff > 0 ? 1 : (colDiff < 0 ? -1 : 0);
+				uint64_t ray = 0;
+				for (int square = from + rowStep * 8 + colStep; square != to; square += rowStep * 8 + colStep)
+				{
+					ray |= 1ULL << square;
+				}
+				rays[from][to] = Bitboard(ray);
+			}
+		}
+
+		return rays;
+	}
+}
+
 namespace PrecomputedData
 {
-	const std::array<uint64_t, 64> rookMagics = {
-		468374916371625120, 18428729537625841661, 2531023729696186408, 6093370314119450896, 13830552789156493815, 16134110446239088507, 12677615322350354425, 5404321144167858432, 2111097758984580, 18428720740584907710, 17293734603602787839, 4938760079889530922, 7699325603589095390, 9078693890218258431, 578149610753690728, 9496543503900033792, 1155209038552629657, 9224076274589515780, 1835781998207181184, 509120063316431138, 16634043024132535807, 18446673631917146111, 9623686630121410312, 4648737361302392899, 738591182849868645, 1732936432546219272, 2400543327507449856, 5188164365601475096, 10414575345181196316, 1162492212166789136, 9396848738060210946, 622413200109881612, 7998357718131801918, 7719627227008073923, 16181433497662382080, 18441958655457754079, 1267153596645440, 18446726464209379263, 1214021438038606600, 4650128814733526084, 9656144899867951104, 18444421868610287615, 3695311799139303489, 10597006226145476632, 18436046904206950398, 18446726472933277663, 3458977943764860944, 39125045590687766, 9227453435446560384, 6476955465732358656, 1270314852531077632, 2882448553461416064, 11547238928203796481, 1856618300822323264, 2573991788166144, 4936544992551831040, 13690941749405253631, 15852669863439351807, 18302628748190527413, 12682135449552027479, 13830554446930287982, 18302628782487371519, 7924083509981736956, 4734295326018586370
+	constexpr std::array<uint64_t, 64> rookMagics = {
+		468374916371625120, 162129724028620801, 792668724158595088, 4107288360135958536, 1261011744021547008, 648522745059016706, 144118521306319360, 5404321144167858432, 2111097758984580, 9336173202503639041, 1153484731586978304, 4938760079889530922, 281509353227280, 281509386781696, 578149610753690728, 9496543503900033792, 1155209038552629657, 9224076274589515780, 1835781998207181184, 509120063316431138, 293860979493044240, 5764749909890696192, 9623686630121410312, 4648737361302392899, 738591182849868645, 1732936432546219272, 4684306708448690308, 1297045490924257408, 10414575345181196316, 1162492212166789136, 9396848738060210946, 622413200109881612, 220746751030591617, 7719627227008073923, 648808754866819136, 4611826790283874304, 1730508191185272836, 5070949783175680, 1214021438038606600, 4650128814733526084, 324399911732805672, 49539871316033540, 3695311799139303489, 10597006226145476632, 577595448370430080, 9570183635075328, 3458977943764860944, 39125045590687766, 9227453435446560384, 6476955465732358656, 1270314852531077632, 2882448553461416064, 72339378253333760, 36314945190627329, 2573991788166144, 4936544992551831040, 13690941749405253631, 15852669863439351807, 18302628748190527413, 12682135449552027479, 13830554446930287982, 18302628782487371519, 7924083509981736956, 4734295326018586370
 	};
 
-	const std::array<uint64_t, 64> bishopMagics = {
+	constexpr std::array<uint64_t, 64> bishopMagics = {
 		16509839532542417919, 14391803910955204223, 1848771770702627364, 347925068195328958, 5189277761285652493, 3750937732777063343, 18429848470517967340, 17870072066711748607, 16715520087474960373, 2459353627279607168, 7061705824611107232, 8089129053103260512, 7414579821471224013, 9520647030890121554, 17142940634164625405, 9187037984654475102, 4933695867036173873, 3035992416931960321, 15052160563071165696, 5876081268917084809, 1153484746652717320, 6365855841584713735, 2463646859659644933, 1453259901463176960, 9808859429721908488, 2829141021535244552, 576619101540319252, 5804014844877275314, 4774660099383771136, 328785038479458864, 2360590652863023124, 569550314443282, 17563974527758635567, 11698101887533589556, 5764964460729992192, 6953579832080335136, 1318441160687747328, 8090717009753444376, 16751172641200572929, 5558033503209157252, 17100156536247493656, 7899286223048400564, 4845135427956654145, 2368485888099072, 2399033289953272320, 6976678428284034058, 3134241565013966284, 8661609558376259840, 17275805361393991679, 15391050065516657151, 11529206229534274423, 9876416274250600448, 16432792402597134585, 11975705497012863580, 11457135419348969979, 9763749252098620046, 16960553411078512574, 15563877356819111679, 14994736884583272463, 9441297368950544394, 14537646123432199168, 9888547162215157388, 18140215579194907366, 18374682062228545019
 	};
 
-	const std::array<int, 64> rookShifts = {
-		52, 52, 52, 52, 52, 52, 52, 52, 53, 53, 53, 54, 53, 53, 54, 53, 53, 54, 54, 54, 53, 53, 54, 53, 53, 54, 53, 53, 54, 54, 54, 53, 52, 54, 53, 53, 53, 53, 54, 53, 52, 53, 54, 54, 53, 53, 54, 53, 53, 54, 54, 54, 53, 53, 54, 53, 52, 53, 53, 53, 53, 53, 53, 52
+	constexpr std::array<int, 64> rookShifts = {
+		52, 53, 53, 53, 53, 53, 53, 52, 53, 54, 54, 54, 54, 54, 54, 53, 53, 54, 54, 54, 54, 54, 54, 53, 53, 54, 54, 54, 54, 54, 54, 53, 53, 54, 54, 54, 54, 54, 54, 53, 53, 54, 54, 54, 54, 54, 54, 53, 53, 54, 54, 54, 54, 54, 54, 53, 52, 53, 53, 53, 53, 53, 53, 52
 	};
 
-	const std::array<int, 64> bishopShifts = {
+	constexpr std::array<int, 64> bishopShifts = {
 		58, 60, 59, 59, 59, 59, 60, 58, 60, 59, 59, 59, 59, 59, 59, 60, 59, 59, 57, 57, 57, 57, 59, 59, 59, 59, 57, 55, 55, 57, 59, 59, 59, 59, 57, 55, 55, 57, 59, 59, 59, 59, 57, 57, 57, 57, 59, 59, 60, 60, 59, 59, 59, 59, 60, 60, 58, 60, 59, 59, 59, 59, 59, 58
 	};
 
-	const std::array<uint64_t, 64> rookMasks = {
+	constexpr std::array<uint64_t, 64> rookMasks = {
 		282578800148862, 565157600297596, 1130315200595066, 2260630401190006, 4521260802379886, 9042521604759646, 18085043209519166, 36170086419038334, 282578800180736, 565157600328704, 1130315200625152, 2260630401218048, 4521260802403840, 9042521604775424, 18085043209518592, 36170086419037696, 282578808340736, 565157608292864, 1130315208328192, 2260630408398848, 4521260808540160, 9042521608822784, 18085043209388032, 36170086418907136, 282580897300736, 565159647117824, 1130317180306432, 2260632246683648, 4521262379438080, 9042522644946944, 18085043175964672, 36170086385483776, 283115671060736, 565681586307584, 1130822006735872, 2261102847592448, 4521664529305600, 9042787892731904, 18085034619584512, 36170077829103616, 420017753620736, 699298018886144, 1260057572672512, 2381576680245248, 4624614895390720, 9110691325681664, 18082844186263552, 36167887395782656, 35466950888980736, 34905104758997504, 34344362452452352, 33222877839362048, 30979908613181440, 26493970160820224, 17522093256097792, 35607136465616896, 9079539427579068672, 8935706818303361536, 8792156787827803136, 8505056726876686336, 7930856604974452736, 6782456361169985536, 4485655873561051136, 9115426935197958144
 	};
 
-	const std::array<uint64_t, 64> bishopMasks = {
+	constexpr std::array<uint64_t, 64> bishopMasks = {
 		18049651735527936, 70506452091904, 275415828992, 1075975168, 38021120, 8657588224, 2216338399232, 567382630219776, 9024825867763712, 18049651735527424, 70506452221952, 275449643008, 9733406720, 2216342585344, 567382630203392, 1134765260406784, 4512412933816832, 9024825867633664, 18049651768822272, 70515108615168, 2491752130560, 567383701868544, 1134765256220672, 2269530512441344, 2256206450263040, 4512412900526080, 9024834391117824, 18051867805491712, 637888545440768, 1135039602493440, 2269529440784384, 4539058881568768, 1128098963916800, 2256197927833600, 4514594912477184, 9592139778506752, 19184279556981248, 2339762086609920, 4538784537380864, 9077569074761728, 562958610993152, 1125917221986304, 2814792987328512, 5629586008178688, 11259172008099840, 22518341868716544, 9007336962655232, 18014673925310464, 2216338399232, 4432676798464, 11064376819712, 22137335185408, 44272556441600, 87995357200384, 35253226045952, 70506452091904, 567382630219776, 1134765260406784, 2832480465846272, 5667157807464448, 11333774449049600, 22526811443298304, 9024825867763712, 18049651735527936
 	};
 
-	const std::array<std::array<Bitboard, 64>, 2> pawnAttacks = {{
+	constexpr std::array<std::array<Bitboard, 64>, 2> pawnAttacks = {{
 		{Bitboard{0}, Bitboard{0}, Bitboard{0}, Bitboard{0}, Bitboard{0}, Bitboard{0}, Bitboard{0}, Bitboard{0}, Bitboard{2}, Bitboard{5}, Bitboard{10}, Bitboard{20}, Bitboard{40}, Bitboard{80}, Bitboard{160}, Bitboard{64}, Bitboard{512}, Bitboard{1280}, Bitboard{2560}, Bitboard{5120}, Bitboard{10240}, Bitboard{20480}, Bitboard{40960}, Bitboard{16384}, Bitboard{131072}, Bitboard{327680}, Bitboard{655360}, Bitboard{1310720}, Bitboard{2621440}, Bitboard{5242880}, Bitboard{10485760}, Bitboard{4194304}, Bitboard{33554432}, Bitboard{83886080}, Bitboard{167772160}, Bitboard{335544320}, Bitboard{671088640}, Bitboard{1342177280}, Bitboard{2684354560}, Bitboard{1073741824}, Bitboard{8589934592}, Bitboard{21474836480}, Bitboard{42949672960}, Bitboard{85899345920}, Bitboard{171798691840}, Bitboard{343597383680}, Bitboard{687194767360}, Bitboard{274877906944}, Bitboard{2199023255552}, Bitboard{5497558138880}, Bitboard{10995116277760}, Bitboard{21990232555520}, Bitboard{43980465111040}, Bitboard{87960930222080}, Bitboard{175921860444160}, Bitboard{70368744177664}, Bitboard{562949953421312}, Bitboard{1407374883553280}, Bitboard{2814749767106560}, Bitboard{5629499534213120}, Bitboard{11258999068426240}, Bitboard{22517998136852480}, Bitboard{45035996273704960}, Bitboard{18014398509481984}},
 		{Bitboard{512}, Bitboard{1280}, Bitboard{2560}, Bitboard{5120}, Bitboard{10240}, Bitboard{20480}, Bitboard{40960}, Bitboard{16384}, Bitboard{131072}, Bitboard{327680}, Bitboard{655360}, Bitboard{1310720}, Bitboard{2621440}, Bitboard{5242880}, Bitboard{10485760}, Bitboard{4194304}, Bitboard{33554432}, Bitboard{83886080}, Bitboard{167772160}, Bitboard{335544320}, Bitboard{671088640}, Bitboard{1342177280}, Bitboard{2684354560}, Bitboard{1073741824}, Bitboard{8589934592}, Bitboard{21474836480}, Bitboard{42949672960}, Bitboard{85899345920}, Bitboard{171798691840}, Bitboard{343597383680}, Bitboard{687194767360}, Bitboard{274877906944}, Bitboard{2199023255552}, Bitboard{5497558138880}, Bitboard{10995116277760}, Bitboard{21990232555520}, Bitboard{43980465111040}, Bitboard{87960930222080}, Bitboard{175921860444160}, Bitboard{70368744177664}, Bitboard{562949953421312}, Bitboard{1407374883553280}, Bitboard{2814749767106560}, Bitboard{5629499534213120}, Bitboard{11258999068426240}, Bitboard{22517998136852480}, Bitboard{45035996273704960}, Bitboard{18014398509481984}, Bitboard{144115188075855872}, Bitboard{360287970189639680}, Bitboard{720575940379279360}, Bitboard{1441151880758558720}, Bitboard{2882303761517117440}, Bitboard{5764607523034234880}, Bitboard{11529215046068469760}, Bitboard{4611686018427387904}, Bitboard{0}, Bitboard{0}, Bitboard{0}, Bitboard{0}, Bitboard{0}, Bitboard{0}, Bitboard{0}, Bitboard{0}}
 	}};
 
-	const std::array<Bitboard, 64> knightAttacks = {
+	constexpr std::array<Bitboard, 64> knightAttacks = {
 		Bitboard{132096}, Bitboard{329728}, Bitboard{659712}, Bitboard{1319424}, Bitboard{2638848}, Bitboard{5277696}, Bitboard{10489856}, Bitboard{4202496}, Bitboard{33816580}, Bitboard{84410376}, Bitboard{168886289}, Bitboard{337772578}, Bitboard{675545156}, Bitboard{1351090312}, Bitboard{2685403152}, Bitboard{1075839008}, Bitboard{8657044482}, Bitboard{21609056261}, Bitboard{43234889994}, Bitboard{86469779988}, Bitboard{172939559976}, Bitboard{345879119952}, Bitboard{687463207072}, Bitboard{275414786112}, Bitboard{2216203387392}, Bitboard{5531918402816}, Bitboard{11068131838464}, Bitboard{22136263676928}, Bitboard{44272527353856}, Bitboard{88545054707712}, Bitboard{175990581010432}, Bitboard{70506185244672}, Bitboard{567348067172352}, Bitboard{1416171111120896}, Bitboard{2833441750646784}, Bitboard{5666883501293568}, Bitboard{11333767002587136}, Bitboard{22667534005174272}, Bitboard{45053588738670592}, Bitboard{18049583422636032}, Bitboard{145241105196122112}, Bitboard{362539804446949376}, Bitboard{725361088165576704}, Bitboard{1450722176331153408}, Bitboard{2901444352662306816}, Bitboard{5802888705324613632}, Bitboard{11533718717099671552}, Bitboard{4620693356194824192}, Bitboard{288234782788157440}, Bitboard{576469569871282176}, Bitboard{1224997833292120064}, Bitboard{2449995666584240128}, Bitboard{4899991333168480256}, Bitboard{9799982666336960512}, Bitboard{1152939783987658752}, Bitboard{2305878468463689728}, Bitboard{1128098930098176}, Bitboard{2257297371824128}, Bitboard{4796069720358912}, Bitboard{9592139440717824}, Bitboard{19184278881435648}, Bitboard{38368557762871296}, Bitboard{4679521487814656}, Bitboard{9077567998918656}
 	};
 
-	const std::array<Bitboard, 64> kingAttacks = {
+	constexpr std::array<Bitboard, 64> kingAttacks = {
 		Bitboard{770}, Bitboard{1797}, Bitboard{3594}, Bitboard{7188}, Bitboard{14376}, Bitboard{28752}, Bitboard{57504}, Bitboard{49216}, Bitboard{197123}, Bitboard{460039}, Bitboard{920078}, Bitboard{1840156}, Bitboard{3680312}, Bitboard{7360624}, Bitboard{14721248}, Bitboard{12599488}, Bitboard{50463488}, Bitboard{117769984}, Bitboard{235539968}, Bitboard{471079936}, Bitboard{942159872}, Bitboard{1884319744}, Bitboard{3768639488}, Bitboard{3225468928}, Bitboard{12918652928}, Bitboard{30149115904}, Bitboard{60298231808}, Bitboard{120596463616}, Bitboard{241192927232}, Bitboard{482385854464}, Bitboard{964771708928}, Bitboard{825720045568}, Bitboard{3307175149568}, Bitboard{7718173671424}, Bitboard{15436347342848}, Bitboard{30872694685696}, Bitboard{61745389371392}, Bitboard{123490778742784}, Bitboard{246981557485568}, Bitboard{211384331665408}, Bitboard{846636838289408}, Bitboard{1975852459884544}, Bitboard{3951704919769088}, Bitboard{7903409839538176}, Bitboard{15806819679076352}, Bitboard{31613639358152704}, Bitboard{63227278716305408}, Bitboard{54114388906344448}, Bitboard{216739030602088448}, Bitboard{505818229730443264}, Bitboard{1011636459460886528}, Bitboard{2023272918921773056}, Bitboard{4046545837843546112}, Bitboard{8093091675687092224}, Bitboard{16186183351374184448}, Bitboard{13853283560024178688}, Bitboard{144959613005987840}, Bitboard{362258295026614272}, Bitboard{724516590053228544}, Bitboard{1449033180106457088}, Bitboard{2898066360212914176}, Bitboard{5796132720425828352}, Bitboard{11592265440851656704}, Bitboard{4665729213955833856}
 	};
-}
+
+	constexpr std::array<uint64_t, ROOK_TABLE_SIZE> rookAttacks = createMagicTable<ROOK_TABLE_SIZE>(rookMasks, rookMagics, rookShifts, true);
+	constexpr std::array<uint64_t, BISHOP_TABLE_SIZE> bishopAttacks = createMagicTable<BISHOP_TABLE_SIZE>(bishopMasks, bishopMagics, bishopShifts, false);
+	constexpr std::array<SliderMagic, 64> rookSliderMagics = createSliderMagics(rookAttacks.data(), rookMasks, rookMagics, rookShifts);
+	constexpr std::array<SliderMagic, 64> bishopSliderMagics = createSliderMagics(bishopAttacks.data(), bishopMasks, bishopMagics, bishopShifts);
+
+#ifdef USE_PEXT
+	constexpr std::array<uint64_t, ROOK_PEXT_TABLE_SIZE> rookPextAttacks = createPextTable<ROOK_PEXT_TABLE_SIZE>(rookMasks, true);
+	constexpr std::array<uint64_t, BISHOP_PEXT_TABLE_SIZE> bishopPextAttacks = createPextTable<BISHOP_PEXT_TABLE_SIZE>(bishopMasks, false);
+	constexpr std::array<uint32_t, 64> rookPextOffsets = createPextOffsets(rookMasks);
+	constexpr std::array<uint32_t, 64> bishopPextOffsets = createPextOffsets(bishopMasks);
+#endif
+
+	constexpr std::array<std::array<Bitboard, 64>, 64> rays = createRays();
+}
\ No newline at end of file
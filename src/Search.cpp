@@ -1,2 +1,312 @@
-// #include "Search.hpp"
+#include "../include/Search.hpp"
+#include "../include/Evalulation.hpp"
+#include "../include/MoveGenerator.hpp"
+#include "../include/MoveValidator.hpp"
+#include "../include/StaticExchange.hpp"
 
+#include <algorithm>
+#include <cstdlib>
+
+Search::Search(Game &game) : game(game), stack(std::make_unique<StackEntry[]>(MAX_PLY + 1))
+{
+}
+
+SearchInfo Search::run(const SearchLimits &limits, Reporter reporter)
+{
+	this->limits = limits;
+	startTime = std::chrono::steady_clock::now();
+	nodes = 0;
+	stopped = false;
+	canStop = false;
+	previousPrincipalVariationLength = 0;
+
+	SearchInfo info;
+	int maxDepth = std::clamp(limits.depth, 1, MAX_PLY);
+	for (int depth = 1; depth <= maxDepth; depth++)
+	{
+		stack[0].onPreviousPrincipalVariation = true;
+		int score = negamax(depth, 0, -INFINITE_SCORE, INFINITE_SCORE);
+
+		// An interrupted iteration did not look at every root move, so its result is thrown away
+		if (stopped)
+		{
+			break;
+		}
+
+		info.depth = depth;
+		info.score = score;
+		info.nodes = nodes;
+		info.seconds = getElapsedSeconds();
+		info.principalVariation.assign(stack[0].principalVariation.begin(), stack[0].principalVariation.begin() + stack[0].principalVariationLength);
+
+		std::copy(stack[0].principalVariation.begin(), stack[0].principalVariation.end(), previousPrincipalVariation.begin());
+		previousPrincipalVariationLength = stack[0].principalVariationLength;
+		canStop = true;
+
+		if (reporter)
+		{
+			reporter(info);
+		}
+
+		// A forced mate found within the depth searched cannot get any shorter, and no move means there is nothing to search
+		if (info.principalVariation.empty() || std::abs(score) >= MATE_SCORE - depth)
+		{
+			break;
+		}
+	}
+
+	return info;
+}
+
+int Search::negamax(int depth, int ply, int alpha, int beta)
+{
+	StackEntry &entry = stack[ply];
+	entry.principalVariationLength = 0;
+	entry.zobristKey = game.getZobristKey();
+
+	if (shouldStop())
+	{
+		return 0;
+	}
+
+	if (ply > 0 && isDraw(ply))
+	{
+		return 0;
+	}
+
+	if (depth <= 0 || ply >= MAX_PLY)
+	{
+		return quiescence(ply, alpha, beta);
+	}
+
+	nodes++;
+	MoveList &moves = entry.moves;
+	MoveGenerator::generateLegalMoves(game, moves);
+	if (moves.empty())
+	{
+		return isInCheck() ? -MATE_SCORE + ply : 0;
+	}
+
+	scoreMoves(moves, ply);
+	int bestScore = -INFINITE_SCORE;
+	for (int i = 0; i < moves.size(); i++)
+	{
+		Move move = pickMove(moves, i);
+		stack[ply + 1].onPreviousPrincipalVariation = entry.onPreviousPrincipalVariation && ply < previousPrincipalVariationLength && move == previousPrincipalVariation[ply];
+
+		game.doMove(move);
+		int score = -negamax(depth - 1, ply + 1, -beta, -alpha);
+		game.undoMove();
+
+		if (stopped)
+		{
+			return 0;
+		}
+
+		if (score > bestScore)
+		{
+			bestScore = score;
+			if (score > alpha)
+			{
+				alpha = score;
+				updatePrincipalVariation(ply, move);
+			}
+		}
+
+		if (alpha >= beta)
+		{
+			break;
+		}
+	}
+
+	return bestScore;
+}
+
+int Search::quiescence(int ply, int alpha, int beta)
+{
+	StackEntry &entry = stack[ply];
+	entry.principalVariationLength = 0;
+
+	if (shouldStop())
+	{
+		return 0;
+	}
+
+	nodes++;
+	Color color = game.getActiveColor();
+	bool inCheck = isInCheck();
+	if (ply >= MAX_PLY)
+	{
+		return Evalulation::evaluate(game.getBoard(), color);
+	}
+
+	// Standing pat is not an option in check, where every evasion is searched instead of only the captures
+	int bestScore = -INFINITE_SCORE;
+	MoveList &moves = entry.moves;
+	if (inCheck)
+	{
+		MoveGenerator::generate<GenType::EVASIONS>(game, moves);
+		if (moves.empty())
+		{
+			return -MATE_SCORE + ply;
+		}
+	}
+	else
+	{
+		bestScore = Evalulation::evaluate(game.getBoard(), color);
+		if (bestScore >= beta)
+		{
+			return bestScore;
+		}
+		alpha = std::max(alpha, bestScore);
+
+		MoveGenerator::generate<GenType::CAPTURES>(game, moves);
+	}
+
+	scoreMoves(moves, ply);
+	for (int i = 0; i < moves.size(); i++)
+	{
+		Move move = pickMove(moves, i);
+
+		// Captures that lose material cannot raise the stand pat score
+		if (!inCheck && !StaticExchange::seeGE(game.getBoard(), move, 0))
+		{
+			continue;
+		}
+
+		stack[ply + 1].onPreviousPrincipalVariation = false;
+		game.doMove(move);
+		int score = -quiescence(ply + 1, -beta, -alpha);
+		game.undoMove();
+
+		if (stopped)
+		{
+			return 0;
+		}
+
+		if (score > bestScore)
+		{
+			bestScore = score;
+			if (score > alpha)
+			{
+				alpha = score;
+				updatePrincipalVariation(ply, move);
+			}
+		}
+
+		if (alpha >= beta)
+		{
+			break;
+		}
+	}
+
+	return bestScore;
+}
+
+void Search::scoreMoves(MoveList &moves, int ply)
+{
+	constexpr int PRINCIPAL_VARIATION_SCORE = 1000000;
+	constexpr int CAPTURE_SCORE = 100000;
+
+	// The last iteration's best line first, then captures that do not lose material, quiet moves, and losing captures last
+	bool hasPrincipalVariationMove = stack[ply].onPreviousPrincipalVariation && ply < previousPrincipalVariationLength;
+	for (int i = 0; i < moves.size(); i++)
+	{
+		Move move = moves[i];
+		int score = 0;
+		if (hasPrincipalVariationMove && move == previousPrincipalVariation[ply])
+		{
+			score = PRINCIPAL_VARIATION_SCORE;
+		}
+		else if (move.isCapture() || move.getSpecialMove() == SpecialMove::PROMOTION)
+		{
+			int exchange = StaticExchange::see(game.getBoard(), move);
+			score = exchange >= 0 ? CAPTURE_SCORE + exchange : -CAPTURE_SCORE + exchange;
+		}
+		moves.setScore(i, score);
+	}
+}
+
+Move Search::pickMove(MoveList &moves, int index)
+{
+	// Selection sort one move at a time, a cutoff usually comes before the list would be fully sorted
+	int best = index;
+	for (int i = index + 1; i < moves.size(); i++)
+	{
+		if (moves.getScore(i) > moves.getScore(best))
+		{
+			best = i;
+		}
+	}
+
+	std::swap(moves[index], moves[best]);
+	int score = moves.getScore(index);
+	moves.setScore(index, moves.getScore(best));
+	moves.setScore(best, score);
+
+	return moves[index];
+}
+
+void Search::updatePrincipalVariation(int ply, Move move)
+{
+	StackEntry &entry = stack[ply];
+	const StackEntry &child = stack[ply + 1];
+
+	entry.principalVariation[0] = move;
+	std::copy(child.principalVariation.begin(), child.principalVariation.begin() + child.principalVariationLength, entry.principalVariation.begin() + 1);
+	entry.principalVariationLength = child.principalVariationLength + 1;
+}
+
+bool Search::isDraw(int ply)
+{
+	int halfMoveClock = game.getHalfMoveClock();
+	if (halfMoveClock >= 100)
+	{
+		return true;
+	}
+
+	// Only positions since the last capture or pawn move can repeat, and only with the same side to move.
+	// Positions played before the search started are not known here
+	for (int i = ply - 2; i >= 0 && i >= ply - halfMoveClock; i -= 2)
+	{
+		if (stack[i].zobristKey == stack[ply].zobristKey)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool Search::isInCheck()
+{
+	Board &board = game.getBoard();
+	Color color = game.getActiveColor();
+	return MoveValidator::isSquareAttacked(board, color, board.getKing(color));
+}
+
+bool Search::shouldStop()
+{
+	if (stopped)
+	{
+		return true;
+	}
+
+	if (!canStop)
+	{
+		return false;
+	}
+
+	// The clock is only read every few thousand nodes
+	if ((limits.nodes > 0 && nodes >= limits.nodes) || (limits.milliseconds > 0 && (nodes & 2047) == 0 && getElapsedSeconds() * 1000 >= limits.milliseconds))
+	{
+		stopped = true;
+	}
+
+	return stopped;
+}
+
+double Search::getElapsedSeconds() const
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+}
\ No newline at end of file
@@ -0,0 +1,191 @@
+#include "../include/StaticExchange.hpp"
+#include "../include/Evalulation.hpp"
+
+#include <algorithm>
+#include <array>
+
+int StaticExchange::see(Board &board, Move move)
+{
+	SpecialMove specialMove = move.getSpecialMove();
+	if (specialMove == SpecialMove::KINGSIDE_CASTLE || specialMove == SpecialMove::QUEENSIDE_CASTLE)
+	{
+		return 0;
+	}
+
+	Exchange exchange = createExchange(board, move);
+	int to = move.getToSquare();
+	Bitboard occupied = exchange.occupied;
+	Bitboard attackers = board.attackersTo(to, occupied) & occupied;
+	Color color = exchange.color;
+	int attackerValue = exchange.attackerValue;
+
+	// Each entry is what the side capturing at that step is up if the exchange stopped right after it
+	std::array<int, 32> gains;
+	gains[0] = exchange.gain;
+	int depth = 0;
+	int value;
+	color = (color == Color::WHITE) ? Color::BLACK : Color::WHITE;
+	while (popLeastValuableAttacker(board, color, to, attackers, occupied, value))
+	{
+		depth++;
+		gains[depth] = attackerValue - gains[depth - 1];
+		attackerValue = value;
+		color = (color == Color::WHITE) ? Color::BLACK : Color::WHITE;
+	}
+
+	// Walk back up the list, a side only recaptures when that does better than stopping
+	for (; depth > 0; depth--)
+	{
+		gains[depth - 1] = -std::max(-gains[depth - 1], gains[depth]);
+	}
+
+	return gains[0];
+}
+
+bool StaticExchange::seeGE(Board &board, Move move, int threshold)
+{
+	SpecialMove specialMove = move.getSpecialMove();
+	if (specialMove == SpecialMove::KINGSIDE_CASTLE || specialMove == SpecialMove::QUEENSIDE_CASTLE)
+	{
+		return threshold <= 0;
+	}
+
+	Exchange exchange = createExchange(board, move);
+
+	// Even if the moving piece is lost for nothing the threshold may be met, or it may be missed before any recapture
+	int swap = exchange.gain - threshold;
+	if (swap < 0)
+	{
+		return false;
+	}
+
+	swap = exchange.attackerValue - swap;
+	if (swap <= 0)
+	{
+		return true;
+	}
+
+	int to = move.getToSquare();
+	Bitboard occupied = exchange.occupied;
+	Bitboard attackers = board.attackersTo(to, occupied) & occupied;
+	Color color = exchange.color;
+	bool result = true;
+	int value;
+
+	// The result flips with every capture, swap is how far the side that just captured is from flipping it back
+	while (true)
+	{
+		color = (color == Color::WHITE) ? Color::BLACK : Color::WHITE;
+		if (!popLeastValuableAttacker(board, color, to, attackers, occupied, value))
+		{
+			break;
+		}
+
+		result = !result;
+		swap = value - swap;
+		if (swap < result)
+		{
+			break;
+		}
+	}
+
+	return result;
+}
+
+StaticExchange::Exchange StaticExchange::createExchange(Board &board, Move move)
+{
+	int from = move.getFromSquare();
+	int to = move.getToSquare();
+
+	Exchange exchange;
+	exchange.color = board.getColorBitboard(Color::WHITE).getBit(from) ? Color::WHITE : Color::BLACK;
+	Color opponentColor = (exchange.color == Color::WHITE) ? Color::BLACK : Color::WHITE;
+	exchange.occupied = board.getOccupiedBitboard();
+	exchange.occupied.clearBit(from);
+	exchange.attackerValue = Evalulation::getPieceValue(board.getPiece(from, exchange.color).value());
+	exchange.gain = 0;
+
+	if (move.getSpecialMove() == SpecialMove::EN_PASSANT)
+	{
+		// The captured pawn is beside the moving pawn, behind the target square
+		int capturedSquare = (exchange.color == Color::WHITE) ? to + 8 : to - 8;
+		exchange.occupied.clearBit(capturedSquare);
+		exchange.gain = Evalulation::getPieceValue(PieceType::PAWN);
+	}
+	else if (std::optional<PieceType> capturedPiece = board.getPiece(to, opponentColor))
+	{
+		exchange.gain = Evalulation::getPieceValue(capturedPiece.value());
+	}
+
+	if (move.getSpecialMove() == SpecialMove::PROMOTION)
+	{
+		PieceType promotedPiece = PieceType::QUEEN;
+		switch (move.getPromotionPiece())
+		{
+			case PromotionPiece::ROOK:
+				promotedPiece = PieceType::ROOK;
+				break;
+			case PromotionPiece::BISHOP:
+				promotedPiece = PieceType::BISHOP;
+				break;
+			case PromotionPiece::KNIGHT:
+				promotedPiece = PieceType::KNIGHT;
+				break;
+			default:
+				break;
+		}
+
+		exchange.attackerValue = Evalulation::getPieceValue(promotedPiece);
+		exchange.gain += exchange.attackerValue - Evalulation::getPieceValue(PieceType::PAWN);
+	}
+
+	return exchange;
+}
+
+bool StaticExchange::popLeastValuableAttacker(Board &board, Color color, int to, Bitboard &attackers, Bitboard &occupied, int &value)
+{
+	Color opponentColor = (color == Color::WHITE) ? Color::BLACK : Color::WHITE;
+	uint64_t colorAttackers = attackers.getValue() & board.getColorBitboard(color).getValue();
+	if (!colorAttackers)
+	{
+		return false;
+	}
+
+	for (PieceType piece : {PieceType::PAWN, PieceType::KNIGHT, PieceType::BISHOP, PieceType::ROOK, PieceType::QUEEN, PieceType::KING})
+	{
+		uint64_t pieceAttackers = colorAttackers & board.getPieceBitboard(piece, color).getValue();
+		if (!pieceAttackers)
+		{
+			continue;
+		}
+
+		// The king can only take last, when nothing is left to take it back
+		if (piece == PieceType::KING && (attackers.getValue() & board.getColorBitboard(opponentColor).getValue()))
+		{
+			return false;
+		}
+
+		value = Evalulation::getPieceValue(piece);
+		occupied.clearBit(__builtin_ctzll(pieceAttackers));
+
+		// Taking the attacker off can uncover a slider behind it on the same line
+		uint64_t xrays = 0;
+		if (piece == PieceType::PAWN || piece == PieceType::BISHOP || piece == PieceType::QUEEN)
+		{
+			uint64_t diagonalSliders = board.getPieceBitboard(PieceType::BISHOP, Color::WHITE).getValue() | board.getPieceBitboard(PieceType::BISHOP, Color::BLACK).getValue()
+				| board.getPieceBitboard(PieceType::QUEEN, Color::WHITE).getValue() | board.getPieceBitboard(PieceType::QUEEN, Color::BLACK).getValue();
+			xrays |= MagicBitboards::getSliderAttacks(to, occupied, PieceType::BISHOP).getValue() & diagonalSliders;
+		}
+		if (piece == PieceType::ROOK || piece == PieceType::QUEEN)
+		{
+			uint64_t orthogonalSliders = board.getPieceBitboard(PieceType::ROOK, Color::WHITE).getValue() | board.getPieceBitboard(PieceType::ROOK, Color::BLACK).getValue()
+				| board.getPieceBitboard(PieceType::QUEEN, Color::WHITE).getValue() | board.getPieceBitboard(PieceType::QUEEN, Color::BLACK).getValue();
+			xrays |= MagicBitboards::getSliderAttacks(to, occupied, PieceType::ROOK).getValue() & orthogonalSliders;
+		}
+
+		attackers = Bitboard((attackers.getValue() | xrays) & occupied.getValue());
+		return true;
+	}
+
+	return false;
+}
\ No newline at end of file
@@ -0,0 +1,62 @@
+#include "../include/Zobrist.hpp"
+
+#include <random>
+
+std::once_flag Zobrist::initFlag;
+
+std::array<std::array<std::array<uint64_t, 64>, 6>, 2> Zobrist::pieceKeys = {};
+uint64_t Zobrist::sideToMoveKey = 0;
+std::array<uint64_t, 16> Zobrist::castlingKeys = {};
+std::array<uint64_t, 8> Zobrist::enPassantKeys = {};
+
+void Zobrist::init()
+{
+	std::call_once(initFlag, []() {
+		// A fixed seed keeps keys, and therefore hashes, identical between runs
+		std::mt19937_64 generator(0x5A5A2024);
+
+		for (auto &colorKeys : pieceKeys)
+		{
+			for (auto &pieceTypeKeys : colorKeys)
+			{
+				for (uint64_t &key : pieceTypeKeys)
+				{
+					key = generator();
+				}
+			}
+		}
+
+		sideToMoveKey = generator();
+
+		for (uint64_t &key : castlingKeys)
+		{
+			key = generator();
+		}
+
+		for (uint64_t &key : enPassantKeys)
+		{
+			key = generator();
+		}
+	});
+}
+
+uint64_t Zobrist::getPieceKey(PieceType piece, Color color, int square)
+{
+	return pieceKeys[static_cast<int>(color)][static_cast<int>(piece)][square];
+}
+
+uint64_t Zobrist::getSideToMoveKey()
+{
+	return sideToMoveKey;
+}
+
+uint64_t Zobrist::getCastlingKey(CastleRights whiteCastleRights, CastleRights blackCastleRights)
+{
+	int rights = whiteCastleRights.canCastleKingSide() | whiteCastleRights.canCastleQueenSide() << 1 | blackCastleRights.canCastleKingSide() << 2 | blackCastleRights.canCastleQueenSide() << 3;
+	return castlingKeys[rights];
+}
+
+uint64_t Zobrist::getEnPassantKey(int file)
+{
+	return enPassantKeys[file];
+}
\ No newline at end of file
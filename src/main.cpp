@@ -1,12 +1,18 @@
 #include <iostream>
 #include <string>
 #include <sstream>
+#include <thread>
+#include <algorithm>
 
 #include "../include/Game.hpp"
 #include "../include/Utility.hpp"
 #include "../include/MagicBitboards.hpp"
+#include "../include/Search.hpp"
 
 int main();
+bool readOptionalNumber(std::istringstream &iss, int &value);
+void runPerft(Game &game, std::string line);
+void runSearch(Game &game, std::string line);
 
 int main()
 {
@@ -39,6 +45,18 @@ int main()
 			continue;
 		}
 
+		if (from == "perft")
+		{
+			runPerft(game, line);
+			continue;
+		}
+
+		if (from == "search")
+		{
+			runSearch(game, line);
+			continue;
+		}
+
 		Position fromPos = Utility::convertStringToPosition(from);
 		Position toPos = Utility::convertStringToPosition(to);
 		PromotionPiece promotionPiece = PromotionPiece::NONE;
@@ -74,4 +92,115 @@ int main()
 	std::cout << game.getBoard().boardToAscii() << std::endl;
 
 	return 0;
+}
+
+// Reads the next argument if there is one, false when it is not a whole number
+bool readOptionalNumber(std::istringstream &iss, int &value)
+{
+	std::string token;
+	if (!(iss >> token))
+	{
+		return true;
+	}
+
+	try
+	{
+		size_t used = 0;
+		int parsed = std::stoi(token, &used);
+		if (used != token.size())
+		{
+			return false;
+		}
+		value = parsed;
+		return true;
+	}
+	catch (const std::exception &e)
+	{
+		return false;
+	}
+}
+
+// perft <depth> [threads] [hash size in MB], with a hash size the run is repeated with a perft cache to show the speedup
+void runPerft(Game &game, std::string line)
+{
+	std::istringstream iss(line);
+	std::string command;
+	int depth = 5;
+	int threadCount = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+	int hashMegabytes = 0;
+
+	// Arguments left off the end of the line keep their defaults
+	iss >> command;
+	if (!readOptionalNumber(iss, depth) || !readOptionalNumber(iss, threadCount) || !readOptionalNumber(iss, hashMegabytes) || depth < 1 || threadCount < 1 || hashMegabytes < 0)
+	{
+		std::cerr << "Usage: perft <depth> [threads] [hash size in MB] - depth and threads must be positive numbers\n\n";
+		return;
+	}
+
+	PerftResult result = game.perftParallel(depth, threadCount);
+	for (const auto &[move, nodes] : result.rootMoveNodes)
+	{
+		std::cout << move << ": " << nodes << "\n";
+	}
+	std::cout << "\nNodes: " << result.nodes << "\n";
+	std::cout << "Time: " << result.seconds << "s\n";
+	std::cout << "NPS: " << static_cast<uint64_t>(result.getNodesPerSecond()) << "\n";
+	for (size_t thread = 0; thread < result.threads.size(); thread++)
+	{
+		std::cout << "Thread " << thread << ": " << result.threads[thread].nodes << " nodes, " << static_cast<uint64_t>(result.threads[thread].getNodesPerSecond()) << " nps\n";
+	}
+
+	if (hashMegabytes > 0)
+	{
+		PerftCache cache(hashMegabytes);
+		PerftResult cachedResult = game.perftParallel(depth, threadCount, &cache);
+
+		std::cout << "\nWith a " << hashMegabytes << " MB cache\n";
+		std::cout << "Nodes: " << cachedResult.nodes << (cachedResult.nodes == result.nodes ? "" : " (MISMATCH)") << "\n";
+		std::cout << "Time: " << cachedResult.seconds << "s\n";
+		std::cout << "Hit rate: " << cachedResult.getCacheHitRate() * 100 << "%\n";
+		std::cout << "Speedup: " << result.seconds / cachedResult.seconds << "x\n";
+	}
+
+	std::cout << std::endl;
+}
+
+// search <depth> [time limit in ms], prints every completed iteration and the best move found
+void runSearch(Game &game, std::string line)
+{
+	std::istringstream iss(line);
+	std::string command;
+	SearchLimits limits;
+	limits.depth = 6;
+
+	int milliseconds = 0;
+	iss >> command;
+	if (!readOptionalNumber(iss, limits.depth) || !readOptionalNumber(iss, milliseconds) || limits.depth < 1 || milliseconds < 0)
+	{
+		std::cerr << "Usage: search <depth> [time limit in ms] - depth must be a positive number\n\n";
+		return;
+	}
+	limits.milliseconds = milliseconds;
+
+	Search search(game);
+	SearchInfo info = search.run(limits, [&](const SearchInfo &report)
+	{
+		std::cout << "depth " << report.depth << " score " << report.score << " nodes " << report.nodes << " nps " << static_cast<uint64_t>(report.getNodesPerSecond()) << " time " << report.seconds << "s pv";
+		for (Move move : report.principalVariation)
+		{
+			std::cout << " " << game.moveToString(move);
+		}
+		std::cout << "\n";
+	});
+
+	std::cout << "Best move:";
+	if (info.principalVariation.empty())
+	{
+		std::cout << " none";
+	}
+	else
+	{
+		std::cout << " " << game.moveToString(info.principalVariation[0]);
+	}
+	std::cout << "\n\n";
 }
\ No newline at end of file
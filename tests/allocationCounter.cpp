@@ -0,0 +1,32 @@
+#include <cstdlib>
+#include <new>
+
+#include "allocationCounter.hpp"
+
+// Every heap allocation in the test binary goes through here, the replacement has to live in exactly one translation unit
+static size_t allocationCount = 0;
+
+size_t getAllocationCount()
+{
+	return allocationCount;
+}
+
+void *operator new(size_t size)
+{
+	allocationCount++;
+	if (void *pointer = std::malloc(size == 0 ? 1 : size))
+	{
+		return pointer;
+	}
+	throw std::bad_alloc();
+}
+
+void operator delete(void *pointer) noexcept
+{
+	std::free(pointer);
+}
+
+void operator delete(void *pointer, size_t) noexcept
+{
+	std::free(pointer);
+}
\ No newline at end of file
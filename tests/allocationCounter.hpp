@@ -0,0 +1,9 @@
+#ifndef ALLOCATIONCOUNTER_HPP
+#define ALLOCATIONCOUNTER_HPP
+
+#include <cstddef>
+
+// Number of heap allocations made so far by the test binary, tests compare it before and after the code they run
+size_t getAllocationCount();
+
+#endif // ALLOCATIONCOUNTER_HPP
\ No newline at end of file
@@ -1,7 +1,9 @@
 #include "gtest/gtest.h"
 
 #include "../include/Board.hpp"
+#include "../include/Game.hpp"
 #include "../include/Utility.hpp"
+#include "allocationCounter.hpp"
 
 struct BoardConstructorTestParams
 {
@@ -25,21 +27,6 @@ struct BoardConstructorTestParams
 class BoardConstructorTest : public ::testing::TestWithParam<BoardConstructorTestParams>
 {
 protected:
-	bool verifyPieceListsPositionsWithBitboards(PieceList pieceList, Bitboard bitboard)
-	{
-		for (int square : pieceList.occupiedSquares)
-		{
-			Position position = Utility::calculatePosition(square);
-
-			if (!bitboard.getBit(position))
-			{
-				return false;
-			}
-		}
-
-		return true;
-	}
-
 	bool verifyKingPositionWithBitboard(int kingSquare, Bitboard bitboard)
 	{
 		Position position = Utility::calculatePosition(kingSquare);
@@ -67,31 +54,6 @@ TEST_P(BoardConstructorTest, BoardConstructor)
 	EXPECT_EQ(board.getPieceBitboard(PieceType::KING, Color::WHITE), Bitboard(params.whiteKings));
 	EXPECT_EQ(board.getPieceBitboard(PieceType::KING, Color::BLACK), Bitboard(params.blackKings));
 
-	// Piece lists - Compares the number of pieces in the piece lists with the number of set bits in the bitboards
-	EXPECT_EQ(board.getPawns(Color::WHITE).count, __builtin_popcountll(params.whitePawns));
-	EXPECT_EQ(board.getPawns(Color::BLACK).count, __builtin_popcountll(params.blackPawns));
-	EXPECT_EQ(board.getKnights(Color::WHITE).count, __builtin_popcountll(params.whiteKnights));
-	EXPECT_EQ(board.getKnights(Color::BLACK).count, __builtin_popcountll(params.blackKnights));
-	EXPECT_EQ(board.getBishops(Color::WHITE).count, __builtin_popcountll(params.whiteBishops));
-	EXPECT_EQ(board.getBishops(Color::BLACK).count, __builtin_popcountll(params.blackBishops));
-	EXPECT_EQ(board.getRooks(Color::WHITE).count, __builtin_popcountll(params.whiteRooks));
-	EXPECT_EQ(board.getRooks(Color::BLACK).count, __builtin_popcountll(params.blackRooks));
-	EXPECT_EQ(board.getQueens(Color::WHITE).count, __builtin_popcountll(params.whiteQueens));
-	EXPECT_EQ(board.getQueens(Color::BLACK).count, __builtin_popcountll(params.blackQueens));
-	// skip kings because there is only one king per color
-
-	// Piece lists - Compares the location of the pieces in the piece lists with the set bits in the bitboards
-	EXPECT_TRUE(verifyPieceListsPositionsWithBitboards(board.getPawns(Color::WHITE), Bitboard(params.whitePawns)));
-	EXPECT_TRUE(verifyPieceListsPositionsWithBitboards(board.getPawns(Color::BLACK), Bitboard(params.blackPawns)));
-	EXPECT_TRUE(verifyPieceListsPositionsWithBitboards(board.getKnights(Color::WHITE), Bitboard(params.whiteKnights)));
-	EXPECT_TRUE(verifyPieceListsPositionsWithBitboards(board.getKnights(Color::BLACK), Bitboard(params.blackKnights)));
-	EXPECT_TRUE(verifyPieceListsPositionsWithBitboards(board.getBishops(Color::WHITE), Bitboard(params.whiteBishops)));
-	EXPECT_TRUE(verifyPieceListsPositionsWithBitboards(board.getBishops(Color::BLACK), Bitboard(params.blackBishops)));
-	EXPECT_TRUE(verifyPieceListsPositionsWithBitboards(board.getRooks(Color::WHITE), Bitboard(params.whiteRooks)));
-	EXPECT_TRUE(verifyPieceListsPositionsWithBitboards(board.getRooks(Color::BLACK), Bitboard(params.blackRooks)));
-	EXPECT_TRUE(verifyPieceListsPositionsWithBitboards(board.getQueens(Color::WHITE), Bitboard(params.whiteQueens)));
-	EXPECT_TRUE(verifyPieceListsPositionsWithBitboards(board.getQueens(Color::BLACK), Bitboard(params.blackQueens)));
-
 	// King positions
 	EXPECT_TRUE(verifyKingPositionWithBitboard(board.getKing(Color::WHITE), Bitboard(params.whiteKings)));
 	EXPECT_TRUE(verifyKingPositionWithBitboard(board.getKing(Color::BLACK), Bitboard(params.blackKings)));
@@ -205,6 +167,7 @@ struct BoardMovePieceParams
 	std::string fenPosition;
 	std::string fenEnPassantTargetSquare;
 	Move move;
+	Color color;
 	std::string expectedFenPosition;
 	std::string expectedFenEnPassantTargetSquare;
 	std::array<int, 5> expectedWhitePieces;
@@ -218,25 +181,42 @@ TEST_P(BoardMovePieceTest, BoardMovePiece)
 	auto params = GetParam();
 	Board board(params.fenPosition, params.fenEnPassantTargetSquare);
 
-	board.movePiece(params.move);
+	board.movePiece(params.move, params.color);
 
 	// Validate fen position and en passant target square - Also validates bitboards because getFenPosition() uses the bitboards
 	EXPECT_EQ(board.getFenPosition(), params.expectedFenPosition);
 	EXPECT_EQ(board.getFenEnPassantTargetSquare(), params.expectedFenEnPassantTargetSquare);
 
 	// Validate white piece counts
-	EXPECT_EQ(board.getPawns(Color::WHITE).count, params.expectedWhitePieces[0]);
-	EXPECT_EQ(board.getKnights(Color::WHITE).count, params.expectedWhitePieces[1]);
-	EXPECT_EQ(board.getBishops(Color::WHITE).count, params.expectedWhitePieces[2]);
-	EXPECT_EQ(board.getRooks(Color::WHITE).count, params.expectedWhitePieces[3]);
-	EXPECT_EQ(board.getQueens(Color::WHITE).count, params.expectedWhitePieces[4]);
+	EXPECT_EQ(__builtin_popcountll(board.getPieceBitboard(PieceType::PAWN, Color::WHITE).getValue()), params.expectedWhitePieces[0]);
+	EXPECT_EQ(__builtin_popcountll(board.getPieceBitboard(PieceType::KNIGHT, Color::WHITE).getValue()), params.expectedWhitePieces[1]);
+	EXPECT_EQ(__builtin_popcountll(board.getPieceBitboard(PieceType::BISHOP, Color::WHITE).getValue()), params.expectedWhitePieces[2]);
+	EXPECT_EQ(__builtin_popcountll(board.getPieceBitboard(PieceType::ROOK, Color::WHITE).getValue()), params.expectedWhitePieces[3]);
+	EXPECT_EQ(__builtin_popcountll(board.getPieceBitboard(PieceType::QUEEN, Color::WHITE).getValue()), params.expectedWhitePieces[4]);
 
 	// Validate black piece counts
-	EXPECT_EQ(board.getPawns(Color::BLACK).count, params.expectedBlackPieces[0]);
-	EXPECT_EQ(board.getKnights(Color::BLACK).count, params.expectedBlackPieces[1]);
-	EXPECT_EQ(board.getBishops(Color::BLACK).count, params.expectedBlackPieces[2]);
-	EXPECT_EQ(board.getRooks(Color::BLACK).count, params.expectedBlackPieces[3]);
-	EXPECT_EQ(board.getQueens(Color::BLACK).count, params.expectedBlackPieces[4]);
+	EXPECT_EQ(__builtin_popcountll(board.getPieceBitboard(PieceType::PAWN, Color::BLACK).getValue()), params.expectedBlackPieces[0]);
+	EXPECT_EQ(__builtin_popcountll(board.getPieceBitboard(PieceType::KNIGHT, Color::BLACK).getValue()), params.expectedBlackPieces[1]);
+	EXPECT_EQ(__builtin_popcountll(board.getPieceBitboard(PieceType::BISHOP, Color::BLACK).getValue()), params.expectedBlackPieces[2]);
+	EXPECT_EQ(__builtin_popcountll(board.getPieceBitboard(PieceType::ROOK, Color::BLACK).getValue()), params.expectedBlackPieces[3]);
+	EXPECT_EQ(__builtin_popcountll(board.getPieceBitboard(PieceType::QUEEN, Color::BLACK).getValue()), params.expectedBlackPieces[4]);
+
+	// Validate the mailbox against the bitboards on every square
+	for (int square = 0; square < 64; square++)
+	{
+		for (Color color : {Color::WHITE, Color::BLACK})
+		{
+			std::optional<PieceType> expectedPiece = std::nullopt;
+			for (PieceType piece : {PieceType::PAWN, PieceType::KNIGHT, PieceType::BISHOP, PieceType::ROOK, PieceType::QUEEN, PieceType::KING})
+			{
+				if (board.getPieceBitboard(piece, color).getBit(square))
+				{
+					expectedPiece = piece;
+				}
+			}
+			EXPECT_EQ(board.getPiece(square, color), expectedPiece);
+		}
+	}
 }
 
 const auto boardMovePieceParams = ::testing::Values(
@@ -244,7 +224,8 @@ const auto boardMovePieceParams = ::testing::Values(
 	BoardMovePieceParams{
 		"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR",
 		"-",
-		Move{Position{Utility::convertStringToPosition("e2")}, Position{Utility::convertStringToPosition("e3")}, PieceType::PAWN, Color::WHITE, std::nullopt, std::nullopt, SpecialMove::NONE, PromotionPiece::NONE, CastleRights{true, true}, CastleRights{true, true}, 0, 1},
+		Move{Position{Utility::convertStringToPosition("e2")}, Position{Utility::convertStringToPosition("e3")}, SpecialMove::NONE, PromotionPiece::NONE, false},
+		Color::WHITE,
 		"rnbqkbnr/pppppppp/8/8/8/4P3/PPPP1PPP/RNBQKBNR",
 		"-",
 		{8, 2, 2, 2, 1},
@@ -253,7 +234,8 @@ const auto boardMovePieceParams = ::testing::Values(
 	BoardMovePieceParams{
 		"rnbqkbnr/pppppppp/8/8/8/4P3/PPPP1PPP/RNBQKBNR",
 		"-",
-		Move{Position{Utility::convertStringToPosition("g8")}, Position{Utility::convertStringToPosition("f6")}, PieceType::KNIGHT, Color::BLACK, std::nullopt, std::nullopt, SpecialMove::NONE, PromotionPiece::NONE, CastleRights{true, true}, CastleRights{true, true}, 0, 2},
+		Move{Position{Utility::convertStringToPosition("g8")}, Position{Utility::convertStringToPosition("f6")}, SpecialMove::NONE, PromotionPiece::NONE, false},
+		Color::BLACK,
 		"rnbqkb1r/pppppppp/5n2/8/8/4P3/PPPP1PPP/RNBQKBNR",
 		"-",
 		{8, 2, 2, 2, 1},
@@ -263,7 +245,8 @@ const auto boardMovePieceParams = ::testing::Values(
 	BoardMovePieceParams{
 		"rnbqkb1r/pp1ppppp/5n2/2p5/3PP3/8/PPP2PPP/RNBQKBNR",
 		"-",
-		Move{Position{Utility::convertStringToPosition("f6")}, Position{Utility::convertStringToPosition("e4")}, PieceType::KNIGHT, Color::BLACK, PieceType::PAWN, std::nullopt, SpecialMove::NONE, PromotionPiece::NONE, CastleRights{true, true}, CastleRights{true, true}, 0, 3},
+		Move{Position{Utility::convertStringToPosition("f6")}, Position{Utility::convertStringToPosition("e4")}, SpecialMove::NONE, PromotionPiece::NONE, true},
+		Color::BLACK,
 		"rnbqkb1r/pp1ppppp/8/2p5/3Pn3/8/PPP2PPP/RNBQKBNR",
 		"-",
 		{7, 2, 2, 2, 1},
@@ -272,7 +255,8 @@ const auto boardMovePieceParams = ::testing::Values(
 	BoardMovePieceParams{
 		"rnbqkb1r/pp1ppppp/8/2p5/3Pn3/8/PPP2PPP/RNBQKBNR",
 		"-",
-		Move{Position{Utility::convertStringToPosition("d4")}, Position{Utility::convertStringToPosition("c5")}, PieceType::PAWN, Color::WHITE, PieceType::PAWN, std::nullopt, SpecialMove::NONE, PromotionPiece::NONE, CastleRights{true, true}, CastleRights{true, true}, 0, 4},
+		Move{Position{Utility::convertStringToPosition("d4")}, Position{Utility::convertStringToPosition("c5")}, SpecialMove::NONE, PromotionPiece::NONE, true},
+		Color::WHITE,
 		"rnbqkb1r/pp1ppppp/8/2P5/4n3/8/PPP2PPP/RNBQKBNR",
 		"-",
 		{7, 2, 2, 2, 1},
@@ -282,7 +266,8 @@ const auto boardMovePieceParams = ::testing::Values(
 	BoardMovePieceParams{
 		"rnbqkbnr/ppp2ppp/8/3Pp3/8/8/PPPP1PPP/RNBQKBNR",
 		"e6",
-		Move{Position{Utility::convertStringToPosition("d5")}, Position{Utility::convertStringToPosition("e6")}, PieceType::PAWN, Color::WHITE, PieceType::PAWN, Utility::convertStringToPosition("e6"), SpecialMove::EN_PASSANT, PromotionPiece::NONE, CastleRights{true, true}, CastleRights{true, true}, 0, 3},
+		Move{Position{Utility::convertStringToPosition("d5")}, Position{Utility::convertStringToPosition("e6")}, SpecialMove::EN_PASSANT, PromotionPiece::NONE, true},
+		Color::WHITE,
 		"rnbqkbnr/ppp2ppp/4P3/8/8/8/PPPP1PPP/RNBQKBNR",
 		"-",
 		{8, 2, 2, 2, 1},
@@ -291,7 +276,8 @@ const auto boardMovePieceParams = ::testing::Values(
 	BoardMovePieceParams{
 		"rnbqkbnr/ppp3pp/8/8/4pP1P/8/PPPP2P1/RNBQKBNR",
 		"f3",
-		Move{Position{Utility::convertStringToPosition("e4")}, Position{Utility::convertStringToPosition("f3")}, PieceType::PAWN, Color::BLACK, PieceType::PAWN, Utility::convertStringToPosition("f3"), SpecialMove::EN_PASSANT, PromotionPiece::NONE, CastleRights{true, true}, CastleRights{true, true}, 0, 6},
+		Move{Position{Utility::convertStringToPosition("e4")}, Position{Utility::convertStringToPosition("f3")}, SpecialMove::EN_PASSANT, PromotionPiece::NONE, true},
+		Color::BLACK,
 		"rnbqkbnr/ppp3pp/8/8/7P/5p2/PPPP2P1/RNBQKBNR",
 		"-",
 		{6, 2, 2, 2, 1},
@@ -301,7 +287,8 @@ const auto boardMovePieceParams = ::testing::Values(
 	BoardMovePieceParams{
 		"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR",
 		"-",
-		Move{Position{Utility::convertStringToPosition("e2")}, Position{Utility::convertStringToPosition("e4")}, PieceType::PAWN, Color::WHITE, std::nullopt, std::nullopt, SpecialMove::DOUBLE_PAWN_PUSH, PromotionPiece::NONE, CastleRights{true, true}, CastleRights{true, true}, 0, 1},
+		Move{Position{Utility::convertStringToPosition("e2")}, Position{Utility::convertStringToPosition("e4")}, SpecialMove::DOUBLE_PAWN_PUSH, PromotionPiece::NONE, false},
+		Color::WHITE,
 		"rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR",
 		"e3",
 		{8, 2, 2, 2, 1},
@@ -311,7 +298,8 @@ const auto boardMovePieceParams = ::testing::Values(
 	BoardMovePieceParams{
 		"r3k2r/pppppppp/8/8/8/8/PPPPPPPP/R3K2R",
 		"-",
-		Move{Position{Utility::convertStringToPosition("e1")}, Position{Utility::convertStringToPosition("g1")}, PieceType::KING, Color::WHITE, std::nullopt, std::nullopt, SpecialMove::KINGSIDE_CASTLE, PromotionPiece::NONE, CastleRights{true, true}, CastleRights{true, true}, 0, 1},
+		Move{Position{Utility::convertStringToPosition("e1")}, Position{Utility::convertStringToPosition("g1")}, SpecialMove::KINGSIDE_CASTLE, PromotionPiece::NONE, false},
+		Color::WHITE,
 		"r3k2r/pppppppp/8/8/8/8/PPPPPPPP/R4RK1",
 		"-",
 		{8, 0, 0, 2, 0},
@@ -320,7 +308,8 @@ const auto boardMovePieceParams = ::testing::Values(
 	BoardMovePieceParams{
 		"r3k2r/pppppppp/8/8/8/8/PPPPPPPP/R3K2R",
 		"-",
-		Move{Position{Utility::convertStringToPosition("e1")}, Position{Utility::convertStringToPosition("c1")}, PieceType::KING, Color::WHITE, std::nullopt, std::nullopt, SpecialMove::QUEENSIDE_CASTLE, PromotionPiece::NONE, CastleRights{true, true}, CastleRights{true, true}, 0, 1},
+		Move{Position{Utility::convertStringToPosition("e1")}, Position{Utility::convertStringToPosition("c1")}, SpecialMove::QUEENSIDE_CASTLE, PromotionPiece::NONE, false},
+		Color::WHITE,
 		"r3k2r/pppppppp/8/8/8/8/PPPPPPPP/2KR3R",
 		"-",
 		{8, 0, 0, 2, 0},
@@ -329,7 +318,8 @@ const auto boardMovePieceParams = ::testing::Values(
 	BoardMovePieceParams{
 		"r3k2r/pppppppp/8/8/8/8/PPPPPPPP/R3K2R",
 		"-",
-		Move{Position{Utility::convertStringToPosition("e8")}, Position{Utility::convertStringToPosition("g8")}, PieceType::KING, Color::BLACK, std::nullopt, std::nullopt, SpecialMove::KINGSIDE_CASTLE, PromotionPiece::NONE, CastleRights{true, true}, CastleRights{true, true}, 0, 1},
+		Move{Position{Utility::convertStringToPosition("e8")}, Position{Utility::convertStringToPosition("g8")}, SpecialMove::KINGSIDE_CASTLE, PromotionPiece::NONE, false},
+		Color::BLACK,
 		"r4rk1/pppppppp/8/8/8/8/PPPPPPPP/R3K2R",
 		"-",
 		{8, 0, 0, 2, 0},
@@ -338,7 +328,8 @@ const auto boardMovePieceParams = ::testing::Values(
 	BoardMovePieceParams{
 		"r3k2r/pppppppp/8/8/8/8/PPPPPPPP/R3K2R",
 		"-",
-		Move{Position{Utility::convertStringToPosition("e8")}, Position{Utility::convertStringToPosition("c8")}, PieceType::KING, Color::BLACK, std::nullopt, std::nullopt, SpecialMove::QUEENSIDE_CASTLE, PromotionPiece::NONE, CastleRights{true, true}, CastleRights{true, true}, 0, 1},
+		Move{Position{Utility::convertStringToPosition("e8")}, Position{Utility::convertStringToPosition("c8")}, SpecialMove::QUEENSIDE_CASTLE, PromotionPiece::NONE, false},
+		Color::BLACK,
 		"2kr3r/pppppppp/8/8/8/8/PPPPPPPP/R3K2R",
 		"-",
 		{8, 0, 0, 2, 0},
@@ -348,7 +339,8 @@ const auto boardMovePieceParams = ::testing::Values(
 	BoardMovePieceParams{
 		"r1bqkbnr/pPpppppp/6n1/8/8/6N1/PpPPPPPP/R1BQKBNR",
 		"-",
-		Move{Position{Utility::convertStringToPosition("b7")}, Position{Utility::convertStringToPosition("b8")}, PieceType::PAWN, Color::WHITE, std::nullopt, std::nullopt, SpecialMove::PROMOTION, PromotionPiece::KNIGHT, CastleRights{true, true}, CastleRights{true, true}, 0, 1},
+		Move{Position{Utility::convertStringToPosition("b7")}, Position{Utility::convertStringToPosition("b8")}, SpecialMove::PROMOTION, PromotionPiece::KNIGHT, false},
+		Color::WHITE,
 		"rNbqkbnr/p1pppppp/6n1/8/8/6N1/PpPPPPPP/R1BQKBNR",
 		"-",
 		{7, 3, 2, 2, 1},
@@ -357,7 +349,8 @@ const auto boardMovePieceParams = ::testing::Values(
 	BoardMovePieceParams{
 		"r1bqkbnr/pPpppppp/6n1/8/8/6N1/PpPPPPPP/R1BQKBNR",
 		"-",
-		Move{Position{Utility::convertStringToPosition("b7")}, Position{Utility::convertStringToPosition("b8")}, PieceType::PAWN, Color::WHITE, std::nullopt, std::nullopt, SpecialMove::PROMOTION, PromotionPiece::BISHOP, CastleRights{true, true}, CastleRights{true, true}, 0, 1},
+		Move{Position{Utility::convertStringToPosition("b7")}, Position{Utility::convertStringToPosition("b8")}, SpecialMove::PROMOTION, PromotionPiece::BISHOP, false},
+		Color::WHITE,
 		"rBbqkbnr/p1pppppp/6n1/8/8/6N1/PpPPPPPP/R1BQKBNR",
 		"-",
 		{7, 2, 3, 2, 1},
@@ -366,7 +359,8 @@ const auto boardMovePieceParams = ::testing::Values(
 	BoardMovePieceParams{
 		"r1bqkbnr/pPpppppp/6n1/8/8/6N1/PpPPPPPP/R1BQKBNR",
 		"-",
-		Move{Position{Utility::convertStringToPosition("b2")}, Position{Utility::convertStringToPosition("b1")}, PieceType::PAWN, Color::BLACK, std::nullopt, std::nullopt, SpecialMove::PROMOTION, PromotionPiece::ROOK, CastleRights{true, true}, CastleRights{true, true}, 0, 1},
+		Move{Position{Utility::convertStringToPosition("b2")}, Position{Utility::convertStringToPosition("b1")}, SpecialMove::PROMOTION, PromotionPiece::ROOK, false},
+		Color::BLACK,
 		"r1bqkbnr/pPpppppp/6n1/8/8/6N1/P1PPPPPP/RrBQKBNR",
 		"-",
 		{8, 2, 2, 2, 1},
@@ -375,7 +369,8 @@ const auto boardMovePieceParams = ::testing::Values(
 	BoardMovePieceParams{
 		"r1bqkbnr/pPpppppp/6n1/8/8/6N1/PpPPPPPP/R1BQKBNR",
 		"-",
-		Move{Position{Utility::convertStringToPosition("b2")}, Position{Utility::convertStringToPosition("b1")}, PieceType::PAWN, Color::BLACK, std::nullopt, std::nullopt, SpecialMove::PROMOTION, PromotionPiece::QUEEN, CastleRights{true, true}, CastleRights{true, true}, 0, 1},
+		Move{Position{Utility::convertStringToPosition("b2")}, Position{Utility::convertStringToPosition("b1")}, SpecialMove::PROMOTION, PromotionPiece::QUEEN, false},
+		Color::BLACK,
 		"r1bqkbnr/pPpppppp/6n1/8/8/6N1/P1PPPPPP/RqBQKBNR",
 		"-",
 		{8, 2, 2, 2, 1},
@@ -471,4 +466,63 @@ const auto getRayTestParams = ::testing::Values(
 	GetRayTestParams{Utility::convertStringToSquareNumber("e6"), Utility::convertStringToSquareNumber("c3"), 0x0ULL}
 );
 
-INSTANTIATE_TEST_SUITE_P(GetRayTests, GetRayTest, getRayTestParams);
\ No newline at end of file
+INSTANTIATE_TEST_SUITE_P(GetRayTests, GetRayTest, getRayTestParams);
+
+struct AttackersToTestParams
+{
+	std::string fenPosition;
+	std::string square;
+	std::vector<std::string> removedSquares;
+	Bitboard expectedAttackers;
+};
+
+class AttackersToTest : public ::testing::TestWithParam<AttackersToTestParams> {};
+
+TEST_P(AttackersToTest, AttackersTo)
+{
+	auto params = GetParam();
+	Board board(params.fenPosition, "-");
+	Bitboard occupied = board.getOccupiedBitboard();
+	for (const std::string &removedSquare : params.removedSquares)
+	{
+		occupied.clearBit(Utility::convertStringToSquareNumber(removedSquare));
+	}
+
+	Bitboard attackers = board.attackersTo(Utility::convertStringToSquareNumber(params.square), occupied);
+	EXPECT_EQ(attackers, params.expectedAttackers);
+}
+
+const auto attackersToTestParams = ::testing::Values(
+	AttackersToTestParams{"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR", "f3", {}, 0x4050000000000000ULL},
+	AttackersToTestParams{"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR", "e4", {}, 0x0ULL},
+	// Pawns, knights and sliders of both colors
+	AttackersToTestParams{"3r3k/8/8/1np1p3/3P4/1N2Q3/5B2/3R2K1", "d4", {}, 0x800120016000008ULL},
+	// Taking the queen off the occupancy uncovers the bishop behind it, the queen itself is still reported
+	AttackersToTestParams{"3r3k/8/8/1np1p3/3P4/1N2Q3/5B2/3R2K1", "d4", {"e3"}, 0x820120016000008ULL}
+);
+
+INSTANTIATE_TEST_SUITE_P(AttackersToTests, AttackersToTest, attackersToTestParams);
+
+TEST(Board, FitsInUnder256Bytes)
+{
+	// Each parallel perft task copies the game and its board, and a small board keeps make and unmake within a few cache lines
+	EXPECT_LT(sizeof(Board), 256);
+}
+
+TEST(BoardAllocation, CopyAndMovePieceMakeNoHeapAllocations)
+{
+	Game game("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+	MoveList moves;
+	game.generateLegalMoves(moves);
+
+	size_t allocationsBefore = getAllocationCount();
+	for (const Move &move : moves)
+	{
+		Board board = game.getBoard();
+		std::optional<PieceType> capturedPiece = board.movePiece(move, Color::WHITE);
+		board.unmovePiece(move, Color::WHITE, capturedPiece);
+	}
+	size_t allocations = getAllocationCount() - allocationsBefore;
+
+	EXPECT_EQ(allocations, 0);
+}
\ No newline at end of file
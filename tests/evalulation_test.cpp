@@ -0,0 +1,28 @@
+#include <gtest/gtest.h>
+
+#include "../include/Evalulation.hpp"
+
+struct EvaluateTestParams
+{
+	std::string fenPosition;
+	Color color;
+	int expectedScore;
+};
+
+class EvaluateTest : public ::testing::TestWithParam<EvaluateTestParams> {};
+
+TEST_P(EvaluateTest, Evaluate)
+{
+	auto params = GetParam();
+	Board board(params.fenPosition, "-");
+	EXPECT_EQ(Evalulation::evaluate(board, params.color), params.expectedScore);
+}
+
+const auto evaluateTestParams = ::testing::Values(
+	EvaluateTestParams{"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR", Color::WHITE, 0},
+	EvaluateTestParams{"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNB1KBNR", Color::WHITE, -900},
+	EvaluateTestParams{"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNB1KBNR", Color::BLACK, 900},
+	EvaluateTestParams{"4k3/8/8/8/8/8/3P4/2N1KB2", Color::WHITE, 750}
+);
+
+INSTANTIATE_TEST_SUITE_P(EvaluateTests, EvaluateTest, evaluateTestParams);
\ No newline at end of file
@@ -51,6 +51,45 @@ const auto gameConstructorTestParams = ::testing::Values(
 
 INSTANTIATE_TEST_SUITE_P(GameConstructorTests, GameConstructorTest, gameConstructorTestParams);
 
+// A reused game must end up identical to a freshly constructed one, whatever it held before
+TEST_P(GameConstructorTest, SetFenMatchesConstructor)
+{
+	auto params = GetParam();
+	Game reusedGame("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+	reusedGame.makeMove(Utility::convertStringToPosition("e2"), Utility::convertStringToPosition("a6"), PromotionPiece::NONE);
+	reusedGame.setFen(params.fen);
+	Game freshGame(params.fen);
+
+	EXPECT_EQ(reusedGame.getFen(), freshGame.getFen());
+	EXPECT_EQ(reusedGame.getZobristKey(), freshGame.getZobristKey());
+	EXPECT_EQ(reusedGame.perft(2), freshGame.perft(2));
+	EXPECT_THROW(reusedGame.unmakeMove(), std::invalid_argument);
+}
+
+class InvalidFenTest : public ::testing::TestWithParam<std::string> {};
+
+// Malformed positions are rejected before anything is placed on the board
+TEST_P(InvalidFenTest, SetFenThrows)
+{
+	Game game("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1");
+	EXPECT_THROW(game.setFen(GetParam()), std::invalid_argument);
+	EXPECT_THROW(Game{GetParam()}, std::invalid_argument);
+}
+
+INSTANTIATE_TEST_SUITE_P(InvalidFenTests, InvalidFenTest, ::testing::Values(
+	"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP w KQkq - 0 1",
+	"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR/8 w KQkq - 0 1",
+	"rnbqkbnr/pppppppp/9/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+	"rnbqkbnrr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+	"rnbqkbn/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+	"rnbqkbnx/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+	"rnbq1bnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQ - 0 1",
+	"4k3/8/QQQQQQQQ/QQQ5/8/8/8/4K3 w - - 0 1",
+	"NNNNNNNN/NN6/8/8/8/8/P7/K6k w - - 0 1",
+	"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq z9 0 1",
+	"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0"
+));
+
 // TODO: Add tests for makeMove
 // ? use this fen: r1bq1rk1/1pp2ppp/p4n2/2bpp3/B2nP3/2NPBP2/PPP3PP/R2QK1NR w KQ d6 0 9 and the move e4 d5, getting bad optional access?
 
@@ -90,21 +129,7 @@ struct GameMakeMoveTestParams
 	std::string expectedFen;
 };
 
-class GameMakeMoveTest : public ::testing::TestWithParam<GameMakeMoveTestParams> {
-	protected:
-		Move composeMove(std::vector<std::string> fenParts, Position from, Position to, PromotionPiece promotionPiece, PieceType pieceType, std::optional<PieceType> capturedPiece, SpecialMove specialMove)
-		{
-			// Because the active color is switched after the move
-			Color activeColor = MoveTest::getActiveColorFromFen(fenParts[1]);
-			CastleRights whiteCastleRights(MoveTest::getCastleRightsFromFen(fenParts[2], Color::WHITE));
-			CastleRights blackCastleRights(MoveTest::getCastleRightsFromFen(fenParts[2], Color::BLACK));
-			std::optional<Position> enPassantSquare = MoveTest::getEnPassantTargetSquareFromFen(fenParts[3]);
-			uint8_t halfMoveClock = std::stoi(fenParts[4]);
-			uint8_t fullMoveNumber = std::stoi(fenParts[5]);
-
-			return Move{from, to, pieceType, activeColor, capturedPiece, enPassantSquare, specialMove, promotionPiece, whiteCastleRights, blackCastleRights, halfMoveClock, fullMoveNumber};
-		}
-};
+class GameMakeMoveTest : public ::testing::TestWithParam<GameMakeMoveTestParams> {};
 
 TEST_P(GameMakeMoveTest, GameMakeMove)
 {
@@ -114,28 +139,35 @@ TEST_P(GameMakeMoveTest, GameMakeMove)
 	Position to = Utility::convertStringToPosition(params.to);
 
 	Game game(params.fen);
+	std::vector<std::string> previousFenParts = game.getFenTokens(params.fen);
+	Color movingColor = game.getActiveColor();
 	game.makeMove(from, to, params.promotionPiece);
 	std::vector<std::string> fenParts = game.getFenTokens(params.expectedFen);
-	Move expectedMove = composeMove(game.getFenTokens(params.fen), from, to, params.promotionPiece, params.pieceType, params.capturedPiece, params.specialMove);
+	Move expectedMove = Move(from, to, params.specialMove, params.promotionPiece, params.capturedPiece.has_value());
 	Move actualMove = game.getLastMove();
-
-	std::optional<Position> test1 = actualMove.getEnPassantTargetSquare();
-	std::optional<Position> test2 = expectedMove.getEnPassantTargetSquare();
+	UndoInfo undoInfo = game.getLastUndoInfo();
 
 	EXPECT_EQ(actualMove.getFrom(), expectedMove.getFrom());
 	EXPECT_EQ(actualMove.getTo(), expectedMove.getTo());
-	EXPECT_EQ(actualMove.getPieceType(), expectedMove.getPieceType());
-	EXPECT_EQ(actualMove.getColor(), expectedMove.getColor());
-	EXPECT_EQ(actualMove.getCapturedPiece(), expectedMove.getCapturedPiece());
-	EXPECT_EQ(actualMove.getEnPassantTargetSquare(), expectedMove.getEnPassantTargetSquare());
 	EXPECT_EQ(actualMove.getSpecialMove(), expectedMove.getSpecialMove());
 	EXPECT_EQ(actualMove.getPromotionPiece(), expectedMove.getPromotionPiece());
-	EXPECT_EQ(actualMove.getWhiteCastleRights(), expectedMove.getWhiteCastleRights());
-	EXPECT_EQ(actualMove.getBlackCastleRights(), expectedMove.getBlackCastleRights());
-	EXPECT_EQ(actualMove.getHalfMoveClock(), expectedMove.getHalfMoveClock());
-	EXPECT_EQ(actualMove.getFullMoveNumber(), expectedMove.getFullMoveNumber());
+	EXPECT_EQ(actualMove.isCapture(), expectedMove.isCapture());
 	EXPECT_EQ(actualMove, expectedMove);
 
+	// The moved piece is on the to square unless it promoted
+	if (params.specialMove != SpecialMove::PROMOTION)
+	{
+		EXPECT_EQ(game.getBoard().getPiece(to, movingColor), params.pieceType);
+	}
+
+	// The undo info holds the state from before the move
+	EXPECT_EQ(undoInfo.move, expectedMove);
+	EXPECT_EQ(undoInfo.capturedPiece, params.capturedPiece);
+	EXPECT_EQ(undoInfo.enPassantTargetSquare, MoveTest::getEnPassantTargetSquareFromFen(previousFenParts[3]));
+	EXPECT_EQ(undoInfo.whiteCastleRights, MoveTest::getCastleRightsFromFen(previousFenParts[2], Color::WHITE));
+	EXPECT_EQ(undoInfo.blackCastleRights, MoveTest::getCastleRightsFromFen(previousFenParts[2], Color::BLACK));
+	EXPECT_EQ(undoInfo.halfMoveClock, std::stoi(previousFenParts[4]));
+
 	EXPECT_EQ(game.getFen(), params.expectedFen);
 	EXPECT_EQ(game.getActiveColor(), MoveTest::getActiveColorFromFen(fenParts[1]));
 	EXPECT_EQ(game.getWhiteCastleRights(), MoveTest::getCastleRightsFromFen(fenParts[2], Color::WHITE));
@@ -235,16 +267,16 @@ TEST_P(GameUnmakeMoveTest, GameUnmakeMove)
 	EXPECT_EQ(game.getFullMoveNumber(), std::stoi(fenParts[5]));
 
 	// Validate piece counts
-	EXPECT_EQ(board.getPawns(Color::WHITE).count, params.expectedPawnCounts[0]);
-	EXPECT_EQ(board.getPawns(Color::BLACK).count, params.expectedPawnCounts[1]);
-	EXPECT_EQ(board.getBishops(Color::WHITE).count, params.expectedBishopCounts[0]);
-	EXPECT_EQ(board.getBishops(Color::BLACK).count, params.expectedBishopCounts[1]);
-	EXPECT_EQ(board.getKnights(Color::WHITE).count, params.expectedKnightCounts[0]);
-	EXPECT_EQ(board.getKnights(Color::BLACK).count, params.expectedKnightCounts[1]);
-	EXPECT_EQ(board.getRooks(Color::WHITE).count, params.expectedRookCounts[0]);
-	EXPECT_EQ(board.getRooks(Color::BLACK).count, params.expectedRookCounts[1]);
-	EXPECT_EQ(board.getQueens(Color::WHITE).count, params.expectedQueenCounts[0]);
-	EXPECT_EQ(board.getQueens(Color::BLACK).count, params.expectedQueenCounts[1]);
+	EXPECT_EQ(__builtin_popcountll(board.getPieceBitboard(PieceType::PAWN, Color::WHITE).getValue()), params.expectedPawnCounts[0]);
+	EXPECT_EQ(__builtin_popcountll(board.getPieceBitboard(PieceType::PAWN, Color::BLACK).getValue()), params.expectedPawnCounts[1]);
+	EXPECT_EQ(__builtin_popcountll(board.getPieceBitboard(PieceType::BISHOP, Color::WHITE).getValue()), params.expectedBishopCounts[0]);
+	EXPECT_EQ(__builtin_popcountll(board.getPieceBitboard(PieceType::BISHOP, Color::BLACK).getValue()), params.expectedBishopCounts[1]);
+	EXPECT_EQ(__builtin_popcountll(board.getPieceBitboard(PieceType::KNIGHT, Color::WHITE).getValue()), params.expectedKnightCounts[0]);
+	EXPECT_EQ(__builtin_popcountll(board.getPieceBitboard(PieceType::KNIGHT, Color::BLACK).getValue()), params.expectedKnightCounts[1]);
+	EXPECT_EQ(__builtin_popcountll(board.getPieceBitboard(PieceType::ROOK, Color::WHITE).getValue()), params.expectedRookCounts[0]);
+	EXPECT_EQ(__builtin_popcountll(board.getPieceBitboard(PieceType::ROOK, Color::BLACK).getValue()), params.expectedRookCounts[1]);
+	EXPECT_EQ(__builtin_popcountll(board.getPieceBitboard(PieceType::QUEEN, Color::WHITE).getValue()), params.expectedQueenCounts[0]);
+	EXPECT_EQ(__builtin_popcountll(board.getPieceBitboard(PieceType::QUEEN, Color::BLACK).getValue()), params.expectedQueenCounts[1]);
 }
 
 auto gameUnmakeMoveTestParams = ::testing::Values(
@@ -316,10 +348,49 @@ TEST(GameUnmakeMoveTest, GameUnmakeMoveEmptyHistory)
 	}, std::invalid_argument);
 }
 
+struct GameDoMoveTestParams
+{
+	std::string fen;
+	Move move;
+	std::string expectedFen;
+};
+
+class GameDoMoveTest : public ::testing::TestWithParam<GameDoMoveTestParams> {};
+
+TEST_P(GameDoMoveTest, GameDoMove)
+{
+	auto params = GetParam();
+	Game game(params.fen);
+
+	game.doMove(params.move);
+	EXPECT_EQ(game.getFen(), params.expectedFen);
+	EXPECT_EQ(game.getLastMove(), params.move);
+
+	game.undoMove();
+	EXPECT_EQ(game.getFen(), params.fen);
+}
+
+auto gameDoMoveTestParams = ::testing::Values(
+	// Double pawn push sets the en passant target square
+	GameDoMoveTestParams{"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", Move(Utility::convertStringToPosition("e2"), Utility::convertStringToPosition("e4"), SpecialMove::DOUBLE_PAWN_PUSH), "rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 1"},
+	// Castling moves the rook and removes both rights
+	GameDoMoveTestParams{"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", Move(Utility::convertStringToPosition("e1"), Utility::convertStringToPosition("g1"), SpecialMove::KINGSIDE_CASTLE), "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R4RK1 b kq - 1 1"},
+	// Regular capture
+	GameDoMoveTestParams{"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R b KQkq - 0 1", Move(Utility::convertStringToPosition("h3"), Utility::convertStringToPosition("g2"), SpecialMove::NONE, PromotionPiece::NONE, true), "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q2/PPPBBPpP/R3K2R w KQkq - 0 2"},
+	// Capturing a rook on its starting square removes the opponent's right on that side
+	GameDoMoveTestParams{"r3k2r/8/8/8/8/8/6b1/R3K2R b KQkq - 0 1", Move(Utility::convertStringToPosition("g2"), Utility::convertStringToPosition("h1"), SpecialMove::NONE, PromotionPiece::NONE, true), "r3k2r/8/8/8/8/8/8/R3K2b w Qkq - 0 2"},
+	// En passant removes the pawn behind the target square
+	GameDoMoveTestParams{"rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6 0 3", Move(Utility::convertStringToPosition("e5"), Utility::convertStringToPosition("f6"), SpecialMove::EN_PASSANT, PromotionPiece::NONE, true), "rnbqkbnr/ppp1p1pp/5P2/3p4/8/8/PPPP1PPP/RNBQKBNR b KQkq - 0 3"},
+	// Capture promotion
+	GameDoMoveTestParams{"r3k2r/1P6/8/8/8/8/8/4K3 w kq - 0 1", Move(Utility::convertStringToPosition("b7"), Utility::convertStringToPosition("a8"), SpecialMove::PROMOTION, PromotionPiece::QUEEN, true), "Q3k2r/8/8/8/8/8/8/4K3 b k - 0 1"}
+);
+
+INSTANTIATE_TEST_SUITE_P(GameDoMoveTests, GameDoMoveTest, gameDoMoveTestParams);
+
 struct PerftTestParams
 {
 	int depth;
-	std::map<std::string, int> expectedOutput;
+	std::map<std::string, uint64_t> expectedOutput;
 };
 
 class PerftTest : public ::testing::TestWithParam<PerftTestParams> {};
@@ -329,7 +400,7 @@ TEST_P(PerftTest, Perft)
 	auto params = GetParam();
 
 	Game game("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1");
-	std::map<std::string, int> output;
+	std::map<std::string, uint64_t> output;
 	game.perftRoot(params.depth, output);
 
 	EXPECT_EQ(output, params.expectedOutput);
@@ -346,13 +417,106 @@ auto perftTestParams = ::testing::Values(
 
 INSTANTIATE_TEST_SUITE_P(PerftTestsStartingPosition, PerftTest, perftTestParams);
 
+struct PerftParallelTestParams
+{
+	std::string fen;
+	int depth;
+	int threadCount;
+	uint64_t expectedNodes;
+};
+
+class PerftParallelTest : public ::testing::TestWithParam<PerftParallelTestParams> {};
+
+TEST_P(PerftParallelTest, PerftParallel)
+{
+	auto params = GetParam();
+	Game game(params.fen);
+
+	PerftResult result = game.perftParallel(params.depth, params.threadCount);
+
+	EXPECT_EQ(result.nodes, params.expectedNodes);
+	EXPECT_EQ(result.threads.size(), params.threadCount);
+
+	// Every node is counted by exactly one thread
+	uint64_t threadNodes = 0;
+	for (const PerftThreadStats &thread : result.threads)
+	{
+		threadNodes += thread.nodes;
+	}
+	EXPECT_EQ(threadNodes, params.expectedNodes);
+
+	// The split is invisible in the per root move counts
+	std::map<std::string, uint64_t> expectedOutput;
+	game.perftRoot(params.depth, expectedOutput);
+	for (const auto &[move, nodes] : result.rootMoveNodes)
+	{
+		EXPECT_EQ(nodes, expectedOutput[move]) << move;
+	}
+	EXPECT_EQ(result.rootMoveNodes.size() + 1, expectedOutput.size());
+}
+
+const auto perftParallelTestParams = ::testing::Values(
+	PerftParallelTestParams{"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", 1, 4, 20},
+	PerftParallelTestParams{"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", 4, 1, 197281},
+	PerftParallelTestParams{"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", 4, 8, 197281},
+	PerftParallelTestParams{"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", 3, 4, 97862},
+	PerftParallelTestParams{"8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1", 5, 16, 674624},
+	PerftParallelTestParams{"r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1", 4, 3, 422333}
+);
+
+INSTANTIATE_TEST_SUITE_P(PerftParallelTests, PerftParallelTest, perftParallelTestParams);
+
+TEST_P(PerftParallelTest, PerftParallelWithCache)
+{
+	auto params = GetParam();
+	Game game(params.fen);
+	PerftCache cache(1);
+
+	// The second run finds the subtrees the first one stored
+	PerftResult first = game.perftParallel(params.depth, params.threadCount, &cache);
+	PerftResult second = game.perftParallel(params.depth, params.threadCount, &cache);
+
+	EXPECT_EQ(first.nodes, params.expectedNodes);
+	EXPECT_EQ(second.nodes, params.expectedNodes);
+	EXPECT_LE(second.cacheHits, second.cacheProbes);
+	if (params.depth >= 3)
+	{
+		EXPECT_GT(second.cacheHits, 0);
+	}
+}
+
+TEST(PerftParallel, RejectsNonPositiveThreadCount)
+{
+	Game game("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1");
+	EXPECT_THROW(game.perftParallel(3, 0), std::invalid_argument);
+	EXPECT_THROW(game.perftParallel(3, -2), std::invalid_argument);
+	EXPECT_EQ(game.perftParallel(3, 1).nodes, 8902);
+}
+
+TEST(PerftCache, ProbeValidatesKeyAndDepth)
+{
+	PerftCache cache(1);
+	uint64_t nodes = 0;
+
+	cache.store(0x1234, 3, 8902);
+	EXPECT_TRUE(cache.probe(0x1234, 3, nodes));
+	EXPECT_EQ(nodes, 8902);
+
+	// Different depth or a different key in the same slot is a miss
+	EXPECT_FALSE(cache.probe(0x1234, 4, nodes));
+	EXPECT_FALSE(cache.probe(0x1234 + cache.getEntryCount(), 3, nodes));
+
+	cache.clear();
+	EXPECT_FALSE(cache.probe(0x1234, 3, nodes));
+}
+
 // TEST(CustomPerft, customFen)
 // {
 // 	Game game("rnbqkbnr/ppp1pppp/8/3p4/8/2P5/PP1PPPPP/RNBQKBNR w KQkq d6 0 2");
-// 	std::map<std::string, int> output;
+// 	std::map<std::string, uint64_t> output;
 // 	game.perftRoot(1, output);
 
-// 	std::map<std::string, int> expectedOutput = {
+// 	std::map<std::string, uint64_t> expectedOutput = {
 // 		{"a2a3", 1},
 // 		{"b2b3", 1},
 // 		{"d2d3", 1},
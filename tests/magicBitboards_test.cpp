@@ -2,14 +2,7 @@
 
 #include "../include/MagicBitboards.hpp"
 
-class MagicBitboardsTest : public ::testing::Test
-{
-protected:
-	void SetUp() override
-	{
-		MagicBitboards::init();
-	}
-};
+class MagicBitboardsTest : public ::testing::Test {};
 
 TEST_F(MagicBitboardsTest, GetRookAttacks)
 {
@@ -51,4 +44,25 @@ TEST_F(MagicBitboardsTest, GetQueenAttacks)
 	ASSERT_EQ(MagicBitboards::getSliderAttacks(16, Bitboard(0x2501804440100051ULL), PieceType::QUEEN).getValue(), 0x10105031e0305ULL);
 	ASSERT_EQ(MagicBitboards::getSliderAttacks(23, Bitboard(0x4401100202400008ULL), PieceType::QUEEN).getValue(), 0x808090a0c040c0a0ULL);
 	ASSERT_EQ(MagicBitboards::getSliderAttacks(48, Bitboard(0x2488480129050440ULL), PieceType::QUEEN).getValue(), 0x30e030508000000ULL);
-}
\ No newline at end of file
+}
+
+#ifdef USE_PEXT
+// Both backends are built from the same masks, so they must agree on every square and occupancy
+TEST_F(MagicBitboardsTest, PextMatchesMagic)
+{
+	uint64_t occupied = 0x9e3779b97f4a7c15ULL;
+	for (int sample = 0; sample < 1000; sample++)
+	{
+		occupied ^= occupied << 13;
+		occupied ^= occupied >> 7;
+		occupied ^= occupied << 17;
+		for (int square = 0; square < 64; square++)
+		{
+			for (PieceType pieceType : {PieceType::ROOK, PieceType::BISHOP, PieceType::QUEEN})
+			{
+				ASSERT_EQ(MagicBitboards::getPextSliderAttacks(square, Bitboard(occupied), pieceType).getValue(), MagicBitboards::getMagicSliderAttacks(square, Bitboard(occupied), pieceType).getValue());
+			}
+		}
+	}
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <iterator>
+
+#include "../include/MoveGenerator.hpp"
+#include "../include/MoveValidator.hpp"
+#include "../include/Utility.hpp"
+
+struct GenerateLegalMovesTestParams
+{
+	std::string fen;
+	int expectedMoveCount;
+};
+
+class GenerateLegalMovesTest : public ::testing::TestWithParam<GenerateLegalMovesTestParams> {};
+
+TEST_P(GenerateLegalMovesTest, GenerateLegalMoves)
+{
+	auto params = GetParam();
+	Game game(params.fen);
+	std::string fen = game.getFen();
+
+	MoveList moves;
+	MoveGenerator::generateLegalMoves(game, moves);
+
+	EXPECT_EQ(moves.size(), params.expectedMoveCount);
+	// Generating moves must leave the position untouched
+	EXPECT_EQ(game.getFen(), fen);
+}
+
+const auto generateLegalMovesTestParams = ::testing::Values(
+	// Standard perft positions
+	GenerateLegalMovesTestParams{"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", 20},
+	GenerateLegalMovesTestParams{"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", 48},
+	GenerateLegalMovesTestParams{"8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1", 14},
+	GenerateLegalMovesTestParams{"r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1", 6},
+	GenerateLegalMovesTestParams{"rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8", 44},
+	GenerateLegalMovesTestParams{"r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10", 46},
+	// Castling is not allowed out of or through check, but is allowed when only the b-file is attacked
+	GenerateLegalMovesTestParams{"r3k2r/8/8/8/8/8/8/R3K1r1 w Qkq - 0 1", 3},
+	GenerateLegalMovesTestParams{"r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 0 1", 26},
+	GenerateLegalMovesTestParams{"1r2k3/8/8/8/8/8/8/R3K3 w Q - 0 1", 16},
+	// En passant capture that would expose the king along the rank
+	GenerateLegalMovesTestParams{"8/8/8/KPp4r/8/8/8/7k w - c6 0 1", 4},
+	// Checkmate and stalemate
+	GenerateLegalMovesTestParams{"rnb1kbnr/pppp1ppp/8/4p3/6Pq/5P2/PPPPP2P/RNBQKBNR w KQkq - 1 3", 0},
+	GenerateLegalMovesTestParams{"7k/5Q2/6K1/8/8/8/8/8 b - - 0 1", 0}
+);
+
+INSTANTIATE_TEST_SUITE_P(GenerateLegalMovesTests, GenerateLegalMovesTest, generateLegalMovesTestParams);
+
+struct GeneratorPerftTestParams
+{
+	std::string fen;
+	int depth;
+	uint64_t expectedNodes;
+};
+
+class GeneratorPerftTest : public ::testing::TestWithParam<GeneratorPerftTestParams> {};
+
+TEST_P(GeneratorPerftTest, GeneratorPerft)
+{
+	auto params = GetParam();
+	Game game(params.fen);
+
+	EXPECT_EQ(game.perft(params.depth), params.expectedNodes);
+}
+
+const auto generatorPerftTestParams = ::testing::Values(
+	GeneratorPerftTestParams{"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", 3, 97862},
+	GeneratorPerftTestParams{"8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1", 4, 43238},
+	GeneratorPerftTestParams{"r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1", 3, 9467},
+	GeneratorPerftTestParams{"rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8", 3, 62379},
+	GeneratorPerftTestParams{"r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10", 3, 89890}
+);
+
+INSTANTIATE_TEST_SUITE_P(GeneratorPerftTests, GeneratorPerftTest, generatorPerftTestParams);
+
+class GenTypeTest : public ::testing::TestWithParam<std::string>
+{
+protected:
+	static std::vector<uint16_t> generate(Game &game, void (*generator)(Game &, MoveList &))
+	{
+		MoveList moves;
+		generator(game, moves);
+		std::vector<uint16_t> values;
+		for (Move move : moves)
+		{
+			values.push_back(move.getValue());
+		}
+		std::sort(values.begin(), values.end());
+		return values;
+	}
+};
+
+// Captures and quiets split the legal moves between them, and evasions are every legal move while in check
+TEST_P(GenTypeTest, CapturesAndQuietsPartitionAllMoves)
+{
+	Game game(GetParam());
+	std::vector<uint16_t> all = generate(game, MoveGenerator::generate<GenType::ALL>);
+	std::vector<uint16_t> captures = generate(game, MoveGenerator::generate<GenType::CAPTURES>);
+	std::vector<uint16_t> quiets = generate(game, MoveGenerator::generate<GenType::QUIETS>);
+
+	std::vector<uint16_t> combined;
+	std::merge(captures.begin(), captures.end(), quiets.begin(), quiets.end(), std::back_inserter(combined));
+	EXPECT_EQ(combined, all);
+
+	MoveList captureMoves;
+	MoveGenerator::generate<GenType::CAPTURES>(game, captureMoves);
+	for (Move move : captureMoves)
+	{
+		EXPECT_TRUE(move.isCapture() || move.getSpecialMove() == SpecialMove::PROMOTION);
+	}
+
+	if (MoveValidator::createLegalityContext(game.getBoard(), game.getActiveColor()).isInCheck())
+	{
+		EXPECT_EQ(generate(game, MoveGenerator::generate<GenType::EVASIONS>), all);
+	}
+}
+
+// Quiet checks are exactly the quiets that leave the opponent king attacked once played
+TEST_P(GenTypeTest, QuietChecksMatchPlayedMoves)
+{
+	Game game(GetParam());
+	MoveList quiets;
+	MoveGenerator::generate<GenType::QUIETS>(game, quiets);
+
+	std::vector<uint16_t> expected;
+	for (Move move : quiets)
+	{
+		game.doMove(move);
+		Board &board = game.getBoard();
+		if (MoveValidator::isSquareAttacked(board, game.getActiveColor(), board.getKing(game.getActiveColor())))
+		{
+			expected.push_back(move.getValue());
+		}
+		game.undoMove();
+	}
+	std::sort(expected.begin(), expected.end());
+
+	EXPECT_EQ(generate(game, MoveGenerator::generate<GenType::QUIET_CHECKS>), expected);
+}
+
+INSTANTIATE_TEST_SUITE_P(GenTypeTests, GenTypeTest, ::testing::Values(
+	"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+	"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+	"8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+	"r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+	"rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+	"r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+	// Discovered checks by a knight, a pawn push and the king, and a rook check from castling
+	"4k3/8/8/8/4N3/8/8/4R1K1 w - - 0 1",
+	"7k/8/8/8/8/2P5/1B6/K7 w - - 0 1",
+	"k7/8/8/8/8/8/K7/R7 w - - 0 1",
+	"5k2/8/8/8/8/8/8/4K2R w K - 0 1",
+	// Black to move, and black in check
+	"r3k2r/8/8/8/8/8/8/R3K2R b KQkq - 0 1",
+	"4k3/8/8/8/8/8/4r3/R3K3 w Q - 0 1"
+));
\ No newline at end of file
@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+
+#include "../include/Game.hpp"
+#include "../include/Utility.hpp"
+#include "allocationCounter.hpp"
+
+TEST(MoveList, AddAndIterate)
+{
+	MoveList moves;
+	Move first = Move(Utility::convertStringToPosition("e2"), Utility::convertStringToPosition("e4"), SpecialMove::DOUBLE_PAWN_PUSH);
+	Move second = Move(Utility::convertStringToPosition("g1"), Utility::convertStringToPosition("f3"));
+
+	EXPECT_TRUE(moves.empty());
+
+	moves.addMove(first);
+	moves.addMove(second);
+	moves.setScore(1, 42);
+
+	EXPECT_EQ(moves.size(), 2);
+	EXPECT_EQ(moves[0], first);
+	EXPECT_EQ(moves[1], second);
+	EXPECT_EQ(moves.getScore(1), 42);
+
+	int iterated = 0;
+	for (const Move &move : moves)
+	{
+		EXPECT_EQ(&move, &moves[iterated]);
+		iterated++;
+	}
+	EXPECT_EQ(iterated, 2);
+
+	moves.clear();
+	EXPECT_TRUE(moves.empty());
+}
+
+struct PerftAllocationTestParams
+{
+	std::string fen;
+	int depth;
+};
+
+class PerftAllocationTest : public ::testing::TestWithParam<PerftAllocationTestParams> {};
+
+TEST_P(PerftAllocationTest, PerftMakesNoHeapAllocations)
+{
+	auto params = GetParam();
+	Game game(params.fen);
+
+	// The first run grows the move history to its final capacity
+	uint64_t expectedNodes = game.perft(params.depth);
+
+	size_t allocationsBefore = getAllocationCount();
+	uint64_t nodes = game.perft(params.depth);
+	size_t allocations = getAllocationCount() - allocationsBefore;
+
+	EXPECT_EQ(nodes, expectedNodes);
+	EXPECT_EQ(allocations, 0);
+}
+
+const auto perftAllocationTestParams = ::testing::Values(
+	PerftAllocationTestParams{"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", 3},
+	PerftAllocationTestParams{"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", 2},
+	PerftAllocationTestParams{"8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1", 3}
+);
+
+INSTANTIATE_TEST_SUITE_P(PerftAllocationTests, PerftAllocationTest, perftAllocationTestParams);
\ No newline at end of file
@@ -235,4 +235,108 @@ const auto findAbsolutePinsTestParams = ::testing::Values(
 
 );
 
-INSTANTIATE_TEST_SUITE_P(findAbsolutePinsTest, findAbsolutePinsTest, findAbsolutePinsTestParams);
\ No newline at end of file
+INSTANTIATE_TEST_SUITE_P(findAbsolutePinsTest, findAbsolutePinsTest, findAbsolutePinsTestParams);
+
+struct CreateLegalityContextTestParams
+{
+	std::string fenPosition;
+	Color color;
+	Bitboard expectedCheckers;
+	Bitboard expectedCheckMask;
+};
+
+class createLegalityContextTest : public ::testing::TestWithParam<CreateLegalityContextTestParams> {};
+
+TEST_P(createLegalityContextTest, createLegalityContext)
+{
+	auto params = GetParam();
+	Board board(params.fenPosition, "-");
+	LegalityContext context = MoveValidator::createLegalityContext(board, params.color);
+	EXPECT_EQ(context.checkers, params.expectedCheckers);
+	EXPECT_EQ(context.checkMask, params.expectedCheckMask);
+}
+
+const auto createLegalityContextTestParams = ::testing::Values(
+	CreateLegalityContextTestParams{"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR", Color::WHITE, Bitboard{0x0ULL}, Bitboard{0xffffffffffffffffULL}},
+	CreateLegalityContextTestParams{"4k3/8/8/8/8/8/8/4K2r", Color::WHITE, Bitboard{0x8000000000000000ULL}, Bitboard{0xe000000000000000ULL}},
+	CreateLegalityContextTestParams{"4k3/8/8/8/8/3n4/8/4K3", Color::WHITE, Bitboard{0x80000000000ULL}, Bitboard{0x80000000000ULL}},
+	CreateLegalityContextTestParams{"4k3/8/8/8/8/8/3p4/4K3", Color::WHITE, Bitboard{0x8000000000000ULL}, Bitboard{0x8000000000000ULL}},
+	CreateLegalityContextTestParams{"4k3/8/8/8/4r3/3n4/8/4K3", Color::WHITE, Bitboard{0x81000000000ULL}, Bitboard{0x0ULL}}
+);
+
+INSTANTIATE_TEST_SUITE_P(createLegalityContextTest, createLegalityContextTest, createLegalityContextTestParams);
+
+struct PinRayTestParams
+{
+	std::string fenPosition;
+	Color color;
+	std::string pinnedSquare;
+	Bitboard expectedPinRay;
+};
+
+class pinRayTest : public ::testing::TestWithParam<PinRayTestParams> {};
+
+TEST_P(pinRayTest, pinRay)
+{
+	auto params = GetParam();
+	Board board(params.fenPosition, "-");
+	LegalityContext context = MoveValidator::createLegalityContext(board, params.color);
+	EXPECT_EQ(context.pinRays[Utility::convertStringToSquareNumber(params.pinnedSquare)], params.expectedPinRay);
+}
+
+const auto pinRayTestParams = ::testing::Values(
+	PinRayTestParams{"3k4/8/8/8/3b4/8/1P6/K7", Color::WHITE, "b2", Bitboard{0x2040800000000ULL}},
+	PinRayTestParams{"3k4/8/r7/8/8/N7/8/K7", Color::WHITE, "a3", Bitboard{0x1010101010000ULL}},
+	PinRayTestParams{"8/8/3k4/3p4/8/5K2/3R4/8", Color::BLACK, "d5", Bitboard{0x8080808000000ULL}}
+);
+
+INSTANTIATE_TEST_SUITE_P(pinRayTest, pinRayTest, pinRayTestParams);
+
+struct GetAttackedSquaresTestParams
+{
+	std::string fenPosition;
+	Color color;
+};
+
+class getAttackedSquaresTest : public ::testing::TestWithParam<GetAttackedSquaresTestParams> {};
+
+// The map of the opponent's attacks must agree with asking about every square on its own
+TEST_P(getAttackedSquaresTest, matchesIsSquareAttacked)
+{
+	auto params = GetParam();
+	Board board(params.fenPosition, "-");
+	Color opponentColor = (params.color == Color::WHITE) ? Color::BLACK : Color::WHITE;
+	Bitboard occupied = board.getOccupiedBitboard();
+	Bitboard attacks = MoveValidator::getAttackedSquares(board, opponentColor, occupied);
+
+	for (int square = 0; square < 64; square++)
+	{
+		EXPECT_EQ(attacks.getBit(square), MoveValidator::isSquareAttacked(board, params.color, square, occupied)) << "square " << square;
+	}
+}
+
+// The context's map is taken with the king off the board, so the squares behind it on a checking line are attacked
+TEST_P(getAttackedSquaresTest, contextRemovesKing)
+{
+	auto params = GetParam();
+	Board board(params.fenPosition, "-");
+	Bitboard occupiedWithoutKing = board.getOccupiedBitboard() & ~Bitboard(1ULL << board.getKing(params.color));
+	LegalityContext context = MoveValidator::createLegalityContext(board, params.color);
+
+	for (int square = 0; square < 64; square++)
+	{
+		EXPECT_EQ(context.opponentAttacks.getBit(square), MoveValidator::isSquareAttacked(board, params.color, square, occupiedWithoutKing)) << "square " << square;
+	}
+}
+
+const auto getAttackedSquaresTestParams = ::testing::Values(
+	GetAttackedSquaresTestParams{"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR", Color::WHITE},
+	GetAttackedSquaresTestParams{"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR", Color::BLACK},
+	GetAttackedSquaresTestParams{"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R", Color::WHITE},
+	GetAttackedSquaresTestParams{"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R", Color::BLACK},
+	GetAttackedSquaresTestParams{"4k3/8/8/8/8/8/8/4K2r", Color::WHITE},
+	GetAttackedSquaresTestParams{"8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8", Color::WHITE},
+	GetAttackedSquaresTestParams{"r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1", Color::BLACK}
+);
+
+INSTANTIATE_TEST_SUITE_P(getAttackedSquaresTest, getAttackedSquaresTest, getAttackedSquaresTestParams);
\ No newline at end of file
@@ -3,25 +3,16 @@
 #include "../include/Move.hpp"
 #include "../include/Utility.hpp"
 #include "../include/structs/Position.hpp"
-#include "../include/structs/CastleRights.hpp"
-#include "../include/enums/Color.hpp"
-#include "../include/enums/PieceType.hpp"
 #include "../include/enums/SpecialMove.hpp"
+#include "../include/enums/PromotionPiece.hpp"
 
 struct MoveConstructorTestParams
 {
 	Position from;
 	Position to;
-	PieceType pieceType;
-	Color color;
-	std::optional<PieceType> capturedPiece;
-	std::optional<Position> enPassantTargetSquare;
 	SpecialMove specialMove;
 	PromotionPiece promotionPiece;
-	CastleRights whiteCastleRights;
-	CastleRights blackCastleRights;
-	uint8_t halfMoveClock;
-	uint16_t fullMoveNumber;
+	bool isCapture;
 };
 
 class MoveConstructorTest : public ::testing::TestWithParam<MoveConstructorTestParams> {};
@@ -29,37 +20,36 @@ class MoveConstructorTest : public ::testing::TestWithParam<MoveConstructorTestP
 TEST_P(MoveConstructorTest, MoveConstructor)
 {
 	auto params = GetParam();
-	Move move(params.from, params.to, params.pieceType, params.color,
-			  params.capturedPiece, params.enPassantTargetSquare,
-			  params.specialMove, params.promotionPiece, params.whiteCastleRights,
-			  params.blackCastleRights, params.halfMoveClock, params.fullMoveNumber);
+	Move move(params.from, params.to, params.specialMove, params.promotionPiece, params.isCapture);
 
 	EXPECT_EQ(move.getFrom(), params.from);
 	EXPECT_EQ(move.getTo(), params.to);
-	EXPECT_EQ(move.getPieceType(), params.pieceType);
-	EXPECT_EQ(move.getColor(), params.color);
-	EXPECT_EQ(move.getCapturedPiece(), params.capturedPiece);
-	EXPECT_EQ(move.getEnPassantTargetSquare(), params.enPassantTargetSquare);
+	EXPECT_EQ(move.getFromSquare(), Utility::calculateSquareNumber(params.from));
+	EXPECT_EQ(move.getToSquare(), Utility::calculateSquareNumber(params.to));
 	EXPECT_EQ(move.getSpecialMove(), params.specialMove);
-	PromotionPiece t = move.getPromotionPiece();
 	EXPECT_EQ(move.getPromotionPiece(), params.promotionPiece);
-	EXPECT_EQ(move.getWhiteCastleRights(), params.whiteCastleRights);
-	EXPECT_EQ(move.getBlackCastleRights(), params.blackCastleRights);
-	EXPECT_EQ(move.getHalfMoveClock(), params.halfMoveClock);
-	EXPECT_EQ(move.getFullMoveNumber(), params.fullMoveNumber);
+	EXPECT_EQ(move.isCapture(), params.isCapture);
+
+	// The square based constructor used by move generation encodes the same move
+	EXPECT_EQ(move, Move(Utility::calculateSquareNumber(params.from), Utility::calculateSquareNumber(params.to), params.specialMove, params.promotionPiece, params.isCapture));
 }
 
 const auto moveConstructorTestParams = ::testing::Values(
-	MoveConstructorTestParams{Position{Utility::convertStringToPosition("a8")}, Position{Utility::convertStringToPosition("b8")}, PieceType::PAWN, Color::WHITE, std::nullopt, std::nullopt, SpecialMove::NONE, PromotionPiece::NONE, CastleRights{true, true}, CastleRights{true, true}, 0, 1},
-	MoveConstructorTestParams{Position{1, 5}, Position{4, 2}, PieceType::KNIGHT, Color::BLACK, std::nullopt, Position{1, 1}, SpecialMove::DOUBLE_PAWN_PUSH, PromotionPiece::NONE, CastleRights{false, true}, CastleRights{true, true}, 4, 10},
-	MoveConstructorTestParams{Position{7, 7}, Position{7, 6}, PieceType::BISHOP, Color::WHITE, PieceType::PAWN, std::nullopt, SpecialMove::EN_PASSANT, PromotionPiece::NONE, CastleRights{true, true}, CastleRights{false, false}, 100, 1000},
-	MoveConstructorTestParams{Position{3, 3}, Position{3, 4}, PieceType::ROOK, Color::BLACK, PieceType::KNIGHT, Position{2, 4}, SpecialMove::KINGSIDE_CASTLE, PromotionPiece::NONE, CastleRights{true, false}, CastleRights{true, true}, 50, 5899},
-	MoveConstructorTestParams{Position{5, 5}, Position{5, 6}, PieceType::QUEEN, Color::WHITE, PieceType::BISHOP, Position{4, 6}, SpecialMove::QUEENSIDE_CASTLE, PromotionPiece::NONE, CastleRights{false, true}, CastleRights{true, false}, 99, 356},
-	MoveConstructorTestParams{Position{6, 6}, Position{6, 7}, PieceType::KING, Color::BLACK, PieceType::ROOK, Position{7, 7}, SpecialMove::PROMOTION, PromotionPiece::KNIGHT, CastleRights{false, false}, CastleRights{false, false}, 1, 2},
-	MoveConstructorTestParams{Position{6, 6}, Position{6, 7}, PieceType::KING, Color::BLACK, PieceType::ROOK, Position{7, 7}, SpecialMove::PROMOTION, PromotionPiece::ROOK, CastleRights{false, false}, CastleRights{false, false}, 1, 2},
-	MoveConstructorTestParams{Position{2, 2}, Position{2, 3}, PieceType::PAWN, Color::WHITE, PieceType::QUEEN, std::nullopt, SpecialMove::PROMOTION, PromotionPiece::QUEEN, CastleRights{true, true}, CastleRights{true, true}, 0, 1},
-	MoveConstructorTestParams{Position{2, 2}, Position{2, 3}, PieceType::PAWN, Color::WHITE, PieceType::QUEEN, std::nullopt, SpecialMove::PROMOTION, PromotionPiece::BISHOP, CastleRights{true, true}, CastleRights{true, true}, 0, 1},
-	MoveConstructorTestParams{Position{4, 4}, Position{4, 5}, PieceType::KNIGHT, Color::BLACK, PieceType::KING, Position{4, 6}, SpecialMove::DOUBLE_PAWN_PUSH, PromotionPiece::NONE, CastleRights{false, true}, CastleRights{true, true}, 4, 10}
+	MoveConstructorTestParams{Position{Utility::convertStringToPosition("a8")}, Position{Utility::convertStringToPosition("b8")}, SpecialMove::NONE, PromotionPiece::NONE, false},
+	MoveConstructorTestParams{Position{Utility::convertStringToPosition("h1")}, Position{Utility::convertStringToPosition("a8")}, SpecialMove::NONE, PromotionPiece::NONE, true},
+	MoveConstructorTestParams{Position{6, 4}, Position{4, 4}, SpecialMove::DOUBLE_PAWN_PUSH, PromotionPiece::NONE, false},
+	MoveConstructorTestParams{Position{3, 3}, Position{2, 4}, SpecialMove::EN_PASSANT, PromotionPiece::NONE, true},
+	MoveConstructorTestParams{Position{7, 4}, Position{7, 6}, SpecialMove::KINGSIDE_CASTLE, PromotionPiece::NONE, false},
+	MoveConstructorTestParams{Position{0, 4}, Position{0, 2}, SpecialMove::QUEENSIDE_CASTLE, PromotionPiece::NONE, false},
+	MoveConstructorTestParams{Position{1, 6}, Position{0, 6}, SpecialMove::PROMOTION, PromotionPiece::QUEEN, false},
+	MoveConstructorTestParams{Position{1, 6}, Position{0, 7}, SpecialMove::PROMOTION, PromotionPiece::ROOK, true},
+	MoveConstructorTestParams{Position{6, 2}, Position{7, 2}, SpecialMove::PROMOTION, PromotionPiece::BISHOP, false},
+	MoveConstructorTestParams{Position{6, 2}, Position{7, 1}, SpecialMove::PROMOTION, PromotionPiece::KNIGHT, true}
 );
 
-INSTANTIATE_TEST_SUITE_P(MoveConstructorTest, MoveConstructorTest, moveConstructorTestParams);
\ No newline at end of file
+INSTANTIATE_TEST_SUITE_P(MoveConstructorTest, MoveConstructorTest, moveConstructorTestParams);
+
+TEST(Move, FitsInTwoBytes)
+{
+	EXPECT_EQ(sizeof(Move), 2);
+}
\ No newline at end of file
@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+
+#include "../include/Search.hpp"
+
+struct SearchBestMoveTestParams
+{
+	std::string fen;
+	int depth;
+	std::string expectedMove;
+	int expectedScore;
+};
+
+class SearchBestMoveTest : public ::testing::TestWithParam<SearchBestMoveTestParams> {};
+
+TEST_P(SearchBestMoveTest, BestMove)
+{
+	auto params = GetParam();
+	Game game(params.fen);
+	std::string fen = game.getFen();
+
+	Search search(game);
+	SearchLimits limits;
+	limits.depth = params.depth;
+	SearchInfo info = search.run(limits);
+
+	ASSERT_FALSE(info.principalVariation.empty());
+	EXPECT_EQ(game.moveToString(info.principalVariation[0]), params.expectedMove);
+	EXPECT_EQ(info.score, params.expectedScore);
+	// Every move played during the search is taken back
+	EXPECT_EQ(game.getFen(), fen);
+}
+
+const auto searchBestMoveTestParams = ::testing::Values(
+	// Back rank mates in one for either side
+	SearchBestMoveTestParams{"6k1/5ppp/8/8/8/8/8/R5K1 w - - 0 1", 3, "a1a8", Search::MATE_SCORE - 1},
+	SearchBestMoveTestParams{"r5k1/8/8/8/8/8/5PPP/6K1 b - - 0 1", 3, "a8a1", Search::MATE_SCORE - 1},
+	// Mate in two, the rook sacrifice opens the pawn's way to b7
+	SearchBestMoveTestParams{"kbK5/pp6/1P6/8/8/8/8/R7 w - - 0 1", 4, "a1a6", Search::MATE_SCORE - 3},
+	// A hanging queen is taken
+	SearchBestMoveTestParams{"4k3/8/8/3q4/8/8/8/3RK3 w - - 0 1", 2, "d1d5", 500}
+);
+
+INSTANTIATE_TEST_SUITE_P(SearchBestMoveTests, SearchBestMoveTest, searchBestMoveTestParams);
+
+TEST(SearchTest, NoLegalMoves)
+{
+	// Stalemate scores as a draw and checkmate as lost, with no move to play in either
+	Game stalemate("7k/5Q2/6K1/8/8/8/8/8 b - - 0 1");
+	SearchInfo stalemateInfo = Search(stalemate).run(SearchLimits{});
+	EXPECT_TRUE(stalemateInfo.principalVariation.empty());
+	EXPECT_EQ(stalemateInfo.score, 0);
+
+	Game checkmate("R5k1/5ppp/8/8/8/8/8/6K1 b - - 0 1");
+	SearchInfo checkmateInfo = Search(checkmate).run(SearchLimits{});
+	EXPECT_TRUE(checkmateInfo.principalVariation.empty());
+	EXPECT_EQ(checkmateInfo.score, -Search::MATE_SCORE);
+}
+
+TEST(SearchTest, ReportsEveryIteration)
+{
+	Game game("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+	Search search(game);
+	SearchLimits limits;
+	limits.depth = 4;
+
+	std::vector<SearchInfo> reports;
+	SearchInfo info = search.run(limits, [&](const SearchInfo &report) { reports.push_back(report); });
+
+	ASSERT_EQ(reports.size(), 4);
+	for (size_t i = 0; i < reports.size(); i++)
+	{
+		EXPECT_EQ(reports[i].depth, i + 1);
+		EXPECT_FALSE(reports[i].principalVariation.empty());
+		EXPECT_LE(reports[i].principalVariation.size(), Search::MAX_PLY);
+		if (i > 0)
+		{
+			EXPECT_GT(reports[i].nodes, reports[i - 1].nodes);
+		}
+	}
+	EXPECT_EQ(info.depth, 4);
+	EXPECT_EQ(info.principalVariation, reports.back().principalVariation);
+}
+
+TEST(SearchTest, StopsAtNodeLimit)
+{
+	Game game("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+	std::string fen = game.getFen();
+	SearchLimits limits;
+	limits.nodes = 20000;
+
+	SearchInfo info = Search(game).run(limits);
+
+	// The result comes from the last iteration that finished under the limit
+	EXPECT_GE(info.depth, 1);
+	EXPECT_LT(info.depth, Search::MAX_PLY);
+	EXPECT_LT(info.nodes, limits.nodes);
+	EXPECT_FALSE(info.principalVariation.empty());
+	EXPECT_EQ(game.getFen(), fen);
+}
+
+TEST(SearchTest, StopsAtTimeLimit)
+{
+	Game game("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+	SearchLimits limits;
+	limits.milliseconds = 50;
+
+	auto start = std::chrono::steady_clock::now();
+	SearchInfo info = Search(game).run(limits);
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	EXPECT_FALSE(info.principalVariation.empty());
+	EXPECT_LT(seconds, 1.0);
+}
\ No newline at end of file
@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+
+#include "../include/MoveGenerator.hpp"
+#include "../include/StaticExchange.hpp"
+#include "../include/Utility.hpp"
+
+struct SeeTestParams
+{
+	std::string fen;
+	std::string from;
+	std::string to;
+	SpecialMove specialMove;
+	PromotionPiece promotionPiece;
+	int expectedValue;
+};
+
+class SeeTest : public ::testing::TestWithParam<SeeTestParams> {};
+
+TEST_P(SeeTest, See)
+{
+	auto params = GetParam();
+	Game game(params.fen);
+	std::string fen = game.getFen();
+	int to = Utility::convertStringToSquareNumber(params.to);
+	bool isCapture = game.getBoard().getOccupiedBitboard().getBit(to) || params.specialMove == SpecialMove::EN_PASSANT;
+	Move move(Utility::convertStringToSquareNumber(params.from), to, params.specialMove, params.promotionPiece, isCapture);
+
+	EXPECT_EQ(StaticExchange::see(game.getBoard(), move), params.expectedValue);
+	EXPECT_TRUE(StaticExchange::seeGE(game.getBoard(), move, params.expectedValue));
+	EXPECT_FALSE(StaticExchange::seeGE(game.getBoard(), move, params.expectedValue + 1));
+	// Nothing is played on the board
+	EXPECT_EQ(game.getFen(), fen);
+}
+
+const auto seeTestParams = ::testing::Values(
+	// An undefended pawn
+	SeeTestParams{"1k1r4/1pp4p/p7/4p3/8/P5P1/1PP4P/2K1R3 w - - 0 1", "e1", "e5", SpecialMove::NONE, PromotionPiece::NONE, 100},
+	// Queens and rooks join the exchange from behind the pieces in front of them, black ends up a knight for a pawn ahead
+	SeeTestParams{"1k1r3q/1ppn3p/p4b2/4p3/8/P2N2P1/1PP1R1BP/2K1Q3 w - - 0 1", "d3", "e5", SpecialMove::NONE, PromotionPiece::NONE, -220},
+	SeeTestParams{"4k3/8/2p5/3p4/8/8/8/3QK3 w - - 0 1", "d1", "d5", SpecialMove::NONE, PromotionPiece::NONE, -800},
+	SeeTestParams{"4k3/8/8/3pP3/8/8/8/4K3 w - d6 0 1", "e5", "d6", SpecialMove::EN_PASSANT, PromotionPiece::NONE, 100},
+	// A quiet move onto a square a pawn attacks loses the piece
+	SeeTestParams{"4k3/8/8/8/3p4/8/8/2B1K3 w - - 0 1", "c1", "e3", SpecialMove::NONE, PromotionPiece::NONE, -330},
+	SeeTestParams{"4k3/8/8/8/8/8/8/R3K3 w - - 0 1", "e1", "c1", SpecialMove::QUEENSIDE_CASTLE, PromotionPiece::NONE, 0},
+	// The king only recaptures when nothing can take it back
+	SeeTestParams{"4k3/4r3/8/8/8/8/8/4R1K1 w - - 0 1", "e1", "e7", SpecialMove::NONE, PromotionPiece::NONE, 0},
+	SeeTestParams{"4k3/4r3/8/8/8/8/4R3/4R1K1 w - - 0 1", "e2", "e7", SpecialMove::NONE, PromotionPiece::NONE, 500},
+	// Promotions count the piece gained, and the promoted piece is what gets recaptured
+	SeeTestParams{"4k3/1P6/8/8/8/8/8/4K3 w - - 0 1", "b7", "b8", SpecialMove::PROMOTION, PromotionPiece::QUEEN, 800},
+	SeeTestParams{"r3k3/1P6/8/8/8/8/8/4K3 w - - 0 1", "b7", "b8", SpecialMove::PROMOTION, PromotionPiece::QUEEN, -100},
+	SeeTestParams{"r3k3/1P6/8/8/8/8/8/4K3 w - - 0 1", "b7", "a8", SpecialMove::PROMOTION, PromotionPiece::KNIGHT, 720},
+	SeeTestParams{"3rk3/8/8/3q4/8/8/8/3RK3 b - - 0 1", "d5", "d1", SpecialMove::NONE, PromotionPiece::NONE, 500}
+);
+
+INSTANTIATE_TEST_SUITE_P(SeeTests, SeeTest, seeTestParams);
+
+class SeeThresholdTest : public ::testing::TestWithParam<std::string> {};
+
+// The early-exit threshold test must agree with the full swap list for every move
+TEST_P(SeeThresholdTest, SeeGEMatchesSee)
+{
+	Game game(GetParam());
+	MoveList moves;
+	MoveGenerator::generateLegalMoves(game, moves);
+
+	for (Move move : moves)
+	{
+		int value = StaticExchange::see(game.getBoard(), move);
+		EXPECT_TRUE(StaticExchange::seeGE(game.getBoard(), move, value)) << Utility::convertPositionToString(move.getFrom()) << Utility::convertPositionToString(move.getTo());
+		EXPECT_FALSE(StaticExchange::seeGE(game.getBoard(), move, value + 1)) << Utility::convertPositionToString(move.getFrom()) << Utility::convertPositionToString(move.getTo());
+	}
+}
+
+INSTANTIATE_TEST_SUITE_P(SeeThresholdTests, SeeThresholdTest, ::testing::Values(
+	"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+	"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+	"r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+	"rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+	"r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+	"2rq1rk1/pb3ppp/1p2p3/8/2PP4/P2B1Q2/5PPP/2R1R1K1 b - - 0 18"
+));
\ No newline at end of file
@@ -0,0 +1,97 @@
+#include "gtest/gtest.h"
+
+#include "../include/Game.hpp"
+#include "../include/Utility.hpp"
+
+namespace ZobristTest
+{
+	Move createMove(std::string from, std::string to, SpecialMove specialMove = SpecialMove::NONE, bool isCapture = false)
+	{
+		return Move(Utility::convertStringToPosition(from), Utility::convertStringToPosition(to), specialMove, PromotionPiece::NONE, isCapture);
+	}
+}
+
+struct ZobristTranspositionTestParams
+{
+	std::string fen;
+	std::vector<Move> firstOrder;
+	std::vector<Move> secondOrder;
+	bool expectedEqual;
+};
+
+class ZobristTranspositionTest : public ::testing::TestWithParam<ZobristTranspositionTestParams> {};
+
+TEST_P(ZobristTranspositionTest, ZobristTransposition)
+{
+	auto params = GetParam();
+	Game first(params.fen);
+	Game second(params.fen);
+
+	for (Move move : params.firstOrder)
+	{
+		first.doMove(move);
+	}
+	for (Move move : params.secondOrder)
+	{
+		second.doMove(move);
+	}
+
+	EXPECT_EQ(first.getZobristKey(), first.computeZobristKey());
+	EXPECT_EQ(second.getZobristKey(), second.computeZobristKey());
+	EXPECT_EQ(first.getZobristKey() == second.getZobristKey(), params.expectedEqual);
+
+	// Keys built from a FEN match keys reached by playing moves
+	EXPECT_EQ(Game(first.getFen()).getZobristKey(), first.getZobristKey());
+}
+
+const auto zobristTranspositionTestParams = ::testing::Values(
+	// Knight moves in either order reach the same position
+	ZobristTranspositionTestParams{
+		"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+		{ZobristTest::createMove("g1", "f3"), ZobristTest::createMove("g8", "f6"), ZobristTest::createMove("b1", "c3"), ZobristTest::createMove("b8", "c6")},
+		{ZobristTest::createMove("b1", "c3"), ZobristTest::createMove("b8", "c6"), ZobristTest::createMove("g1", "f3"), ZobristTest::createMove("g8", "f6")},
+		true
+	},
+	// Same pieces but a different side to move
+	ZobristTranspositionTestParams{
+		"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+		{ZobristTest::createMove("g1", "f3"), ZobristTest::createMove("g8", "f6"), ZobristTest::createMove("f3", "g1"), ZobristTest::createMove("f6", "g8")},
+		{ZobristTest::createMove("g1", "f3"), ZobristTest::createMove("g8", "f6"), ZobristTest::createMove("f3", "g1")},
+		false
+	},
+	// Same pieces but the king has moved, losing castling rights
+	ZobristTranspositionTestParams{
+		"r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 0 1",
+		{ZobristTest::createMove("a1", "b1"), ZobristTest::createMove("a8", "b8"), ZobristTest::createMove("b1", "a1"), ZobristTest::createMove("b8", "a8")},
+		{ZobristTest::createMove("h1", "g1"), ZobristTest::createMove("h8", "g8"), ZobristTest::createMove("g1", "h1"), ZobristTest::createMove("g8", "h8")},
+		false
+	}
+);
+
+INSTANTIATE_TEST_SUITE_P(ZobristTranspositionTests, ZobristTranspositionTest, zobristTranspositionTestParams);
+
+TEST(ZobristTest, EnPassantTargetSquareChangesKey)
+{
+	Game game("4k3/8/8/8/8/8/4P3/4K3 w - - 0 1");
+	game.doMove(ZobristTest::createMove("e2", "e4", SpecialMove::DOUBLE_PAWN_PUSH));
+
+	EXPECT_EQ(game.getZobristKey(), Game("4k3/8/8/8/4P3/8/8/4K3 b - e3 0 1").getZobristKey());
+	EXPECT_NE(game.getZobristKey(), Game("4k3/8/8/8/4P3/8/8/4K3 b - - 0 1").getZobristKey());
+}
+
+TEST(ZobristTest, UndoMoveRestoresKey)
+{
+	Game game("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+	uint64_t initialKey = game.getZobristKey();
+	MoveList moves;
+	game.generateLegalMoves(moves);
+
+	for (const Move &move : moves)
+	{
+		game.doMove(move);
+		EXPECT_EQ(game.getZobristKey(), game.computeZobristKey());
+		EXPECT_NE(game.getZobristKey(), initialKey);
+		game.undoMove();
+		EXPECT_EQ(game.getZobristKey(), initialKey);
+	}
+}
\ No newline at end of file